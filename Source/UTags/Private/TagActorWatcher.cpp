@@ -0,0 +1,40 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagActorWatcher.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+// Called when a watched actor is destroyed
+FOnTagActorDestroyed& UTagActorWatcher::OnActorDestroyed()
+{
+	static FOnTagActorDestroyed ActorDestroyed;
+	return ActorDestroyed;
+}
+
+// Get notified when the actor is destroyed (binding an actor twice has no effect)
+void UTagActorWatcher::Watch(AActor* Actor)
+{
+	if (Actor)
+	{
+		Actor->OnDestroyed.AddUniqueDynamic(Get(), &UTagActorWatcher::HandleActorDestroyed);
+	}
+}
+
+// Bound to the OnDestroyed of the watched actors
+void UTagActorWatcher::HandleActorDestroyed(AActor* DestroyedActor)
+{
+	OnActorDestroyed().Broadcast(DestroyedActor);
+}
+
+// Get the rooted watcher instance
+UTagActorWatcher* UTagActorWatcher::Get()
+{
+	static UTagActorWatcher* Watcher = nullptr;
+	if (Watcher == nullptr)
+	{
+		Watcher = NewObject<UTagActorWatcher>(GetTransientPackage());
+		Watcher->AddToRoot();
+	}
+	return Watcher;
+}
@@ -0,0 +1,36 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "TagActorWatcher.generated.h"
+
+class AActor;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTagActorDestroyed, AActor* /*Actor*/);
+
+/**
+* Forwards the OnDestroyed events of the watched actors (in game, PIE and editor worlds)
+* to a native delegate, the world indices use it to drop the destroyed actors
+*/
+UCLASS(Transient)
+class UTagActorWatcher : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Called when a watched actor is destroyed
+	static FOnTagActorDestroyed& OnActorDestroyed();
+
+	// Get notified when the actor is destroyed (binding an actor twice has no effect)
+	static void Watch(AActor* Actor);
+
+private:
+	// Bound to the OnDestroyed of the watched actors
+	UFUNCTION()
+	void HandleActorDestroyed(AActor* DestroyedActor);
+
+	// Get the rooted watcher instance
+	static UTagActorWatcher* Get();
+};
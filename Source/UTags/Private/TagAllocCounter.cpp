@@ -0,0 +1,167 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagAllocCounter.h"
+
+#if !UE_BUILD_SHIPPING
+#include "UTags.h"
+#include "RenderingThread.h"
+
+// Install the counter on top of the global allocator, nullptr if not called from the game thread or already installed
+FTagAllocCounter* FTagAllocCounter::Install()
+{
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTags, Warning, TEXT("%s::%d The allocation counter can only be installed from the game thread.."),
+			*FString(__func__), __LINE__);
+		return nullptr;
+	}
+
+	FTagAllocCounter& Counter = GetInstance();
+	if (Counter.bInstalled)
+	{
+		UE_LOG(LogTags, Warning, TEXT("%s::%d The allocation counter is already installed.."),
+			*FString(__func__), __LINE__);
+		return nullptr;
+	}
+
+	// Swap the global allocator with the rendering thread idle
+	FlushRenderingCommands();
+	Counter.Inner = GMalloc;
+	Counter.CountingThreadId = 0;
+	Counter.bInstalled = true;
+	FPlatformMisc::MemoryBarrier();
+	GMalloc = &Counter;
+	return &Counter;
+}
+
+// Restore the global allocator wrapped by the counter
+void FTagAllocCounter::Uninstall()
+{
+	check(IsInGameThread());
+	FTagAllocCounter& Counter = GetInstance();
+	if (!Counter.bInstalled)
+	{
+		return;
+	}
+
+	// Another allocator installed on top of the counter keeps forwarding to it
+	if (GMalloc != &Counter)
+	{
+		UE_LOG(LogTags, Warning, TEXT("%s::%d The global allocator was replaced after the allocation counter, it is kept installed.."),
+			*FString(__func__), __LINE__);
+		return;
+	}
+
+	FlushRenderingCommands();
+	Counter.CountingThreadId = 0;
+	Counter.bInstalled = false;
+	FPlatformMisc::MemoryBarrier();
+	GMalloc = Counter.Inner;
+}
+
+// Start counting the allocations of the calling thread
+void FTagAllocCounter::Start()
+{
+	NumAllocs = 0;
+	CountingThreadId = FPlatformTLS::GetCurrentThreadId();
+}
+
+// Stop counting, returns the number of allocations since Start
+int64 FTagAllocCounter::Stop()
+{
+	CountingThreadId = 0;
+	return NumAllocs;
+}
+
+// FMalloc interface
+void* FTagAllocCounter::Malloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAlloc();
+	return Inner->Malloc(Count, Alignment);
+}
+
+void* FTagAllocCounter::Realloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	CountAlloc();
+	return Inner->Realloc(Original, Count, Alignment);
+}
+
+void FTagAllocCounter::Free(void* Original)
+{
+	Inner->Free(Original);
+}
+
+SIZE_T FTagAllocCounter::QuantizeSize(SIZE_T Count, uint32 Alignment)
+{
+	return Inner->QuantizeSize(Count, Alignment);
+}
+
+bool FTagAllocCounter::GetAllocationSize(void* Original, SIZE_T& SizeOut)
+{
+	return Inner->GetAllocationSize(Original, SizeOut);
+}
+
+void FTagAllocCounter::Trim()
+{
+	Inner->Trim();
+}
+
+void FTagAllocCounter::SetupTLSCachesOnCurrentThread()
+{
+	Inner->SetupTLSCachesOnCurrentThread();
+}
+
+void FTagAllocCounter::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	Inner->ClearAndDisableTLSCachesOnCurrentThread();
+}
+
+void FTagAllocCounter::InitializeStatsMetadata()
+{
+	Inner->InitializeStatsMetadata();
+}
+
+void FTagAllocCounter::UpdateStats()
+{
+	Inner->UpdateStats();
+}
+
+void FTagAllocCounter::GetAllocatorStats(FGenericMemoryStats& OutStats)
+{
+	Inner->GetAllocatorStats(OutStats);
+}
+
+void FTagAllocCounter::DumpAllocatorStats(FOutputDevice& Ar)
+{
+	Inner->DumpAllocatorStats(Ar);
+}
+
+bool FTagAllocCounter::IsInternallyThreadSafe() const
+{
+	return Inner->IsInternallyThreadSafe();
+}
+
+bool FTagAllocCounter::ValidateHeap()
+{
+	return Inner->ValidateHeap();
+}
+
+const TCHAR* FTagAllocCounter::GetDescriptiveName()
+{
+	return Inner->GetDescriptiveName();
+}
+
+// FExec interface
+bool FTagAllocCounter::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	return Inner->Exec(InWorld, Cmd, Ar);
+}
+
+// The counter instance (never deleted, threads still holding the previous global allocator keep forwarding through it)
+FTagAllocCounter& FTagAllocCounter::GetInstance()
+{
+	static FTagAllocCounter Instance;
+	return Instance;
+}
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,112 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+/**
+* Counts the allocations made by the thread which started the counting
+*
+* Installed on top of the global allocator only while a FTagAllocCounterScope is alive
+* (from the game thread, with the rendering commands flushed), the previous global
+* allocator is restored when the scope ends; every allocator call is forwarded,
+* the allocations of the other threads are not counted
+*
+*	FTagAllocCounterScope CounterScope;
+*	if (FTagAllocCounter* Counter = CounterScope.Get())
+*	{
+*		Counter->Start();
+*		..
+*		const int64 NumAllocs = Counter->Stop();
+*	}
+*/
+class FTagAllocCounter : public FMalloc
+{
+public:
+	// Install the counter on top of the global allocator, nullptr if not called from the game thread or already installed
+	static FTagAllocCounter* Install();
+
+	// Restore the global allocator wrapped by the counter
+	static void Uninstall();
+
+	// Start counting the allocations of the calling thread
+	void Start();
+
+	// Stop counting, returns the number of allocations since Start
+	int64 Stop();
+
+	// FMalloc interface
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void Free(void* Original) override;
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override;
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override;
+	virtual void Trim() override;
+	virtual void SetupTLSCachesOnCurrentThread() override;
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+	virtual void InitializeStatsMetadata() override;
+	virtual void UpdateStats() override;
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override;
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override;
+	virtual bool IsInternallyThreadSafe() const override;
+	virtual bool ValidateHeap() override;
+	virtual const TCHAR* GetDescriptiveName() override;
+
+	// FExec interface
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override;
+
+private:
+	// Use Install()
+	FTagAllocCounter() : Inner(nullptr), bInstalled(false), CountingThreadId(0), NumAllocs(0) {}
+
+	// The counter instance (never deleted, threads still holding the previous global allocator keep forwarding through it)
+	static FTagAllocCounter& GetInstance();
+
+	// Count the allocation if it is made by the counting thread
+	FORCEINLINE void CountAlloc()
+	{
+		if (CountingThreadId != 0 && CountingThreadId == FPlatformTLS::GetCurrentThreadId())
+		{
+			++NumAllocs;
+		}
+	}
+
+	// The wrapped global allocator
+	FMalloc* Inner;
+
+	// True while the counter is the global allocator
+	bool bInstalled;
+
+	// Id of the counting thread, 0 if not counting
+	volatile uint32 CountingThreadId;
+
+	// Allocations of the counting thread (only written by it)
+	int64 NumAllocs;
+};
+
+/**
+* Installs the allocation counter for the lifetime of the scope
+*/
+class FTagAllocCounterScope
+{
+public:
+	// Install the counter
+	FTagAllocCounterScope() : Counter(FTagAllocCounter::Install()) {}
+
+	// Restore the global allocator
+	~FTagAllocCounterScope()
+	{
+		if (Counter)
+		{
+			FTagAllocCounter::Uninstall();
+		}
+	}
+
+	// Get the installed counter, nullptr if it could not be installed
+	FTagAllocCounter* Get() const { return Counter; }
+
+private:
+	FTagAllocCounter* Counter;
+};
+#endif // !UE_BUILD_SHIPPING
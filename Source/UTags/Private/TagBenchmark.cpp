@@ -0,0 +1,505 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+#include "UTags.h"
+#include "Tags.h"
+#include "TagIndex.h"
+#include "TagQuery.h"
+#include "TagDelimiterScan.h"
+#include "TagAllocCounter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Components/SceneComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+
+/**
+* Benchmark of the FTags entry points over synthetic worlds
+*
+*	UTags.Benchmark [Actors=1000,10000,100000] [Components=2] [Tags=2] [Repeats=3]
+*
+* Every actor and component gets one "Bench" tag (Id, Class, Group) and (Tags - 1) extra tags,
+* the results (ns/op, allocations/op, peak memory) are written to Saved/UTags/Benchmark_<time>.csv,
+* only the allocations of the calling thread are counted (not the ones of the parallel scan workers)
+*/
+namespace
+{
+	// Benchmark settings
+	struct FBenchSettings
+	{
+		TArray<int32> NumActors;
+		int32 NumComponents = 2;
+		int32 NumTags = 2;
+		int32 NumRepeats = 3;
+	};
+
+	// One measured case
+	struct FBenchResult
+	{
+		FString Name;
+		FString Scope;
+		int32 NumActors;
+		int32 NumObjects;
+		bool bIndexed;
+		int64 NumOps;
+		double NsPerOp;
+		double AllocsPerOp;
+		uint64 PeakUsedPhysical;
+	};
+
+	// The synthetic world and its objects
+	struct FBenchWorld
+	{
+		UWorld* World = nullptr;
+		TArray<AActor*> Actors;
+		TArray<UActorComponent*> Components;
+		TArray<FName> SampleTags;
+	};
+
+	// Number of distinct class values
+	constexpr int32 NumClasses = 16;
+
+	// Queried tag
+	const FString BenchType = TEXT("Bench");
+	const FString BenchKey = TEXT("Class");
+	const FString BenchValue = TEXT("Class3");
+
+	// Build the tags of a synthetic object
+	void BuildTags(int32 ObjectIdx, int32 NumTags, TArray<FName>& OutTags)
+	{
+		OutTags.Reset();
+		OutTags.Emplace(*FString::Printf(TEXT("Bench;Id,%08X;Class,Class%d;Group,G%d;"), ObjectIdx, ObjectIdx % NumClasses, ObjectIdx % 7));
+		for (int32 TagIdx = 1; TagIdx < NumTags; ++TagIdx)
+		{
+			OutTags.Emplace(*FString::Printf(TEXT("Extra%d;Key,Value%d;Other,%d;"), TagIdx, ObjectIdx % 5, TagIdx));
+		}
+	}
+
+	// Create a transient world with the actors, components and tags
+	FBenchWorld CreateBenchWorld(int32 NumActors, const FBenchSettings& Settings)
+	{
+		FBenchWorld Bench;
+		Bench.World = UWorld::CreateWorld(EWorldType::GamePreview, false, FName(TEXT("UTagsBenchmark")));
+		FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::GamePreview);
+		Context.SetCurrentWorld(Bench.World);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		int32 ObjectIdx = 0;
+		for (int32 ActIdx = 0; ActIdx < NumActors; ++ActIdx)
+		{
+			AActor* Actor = Bench.World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+			BuildTags(ObjectIdx++, Settings.NumTags, Actor->Tags);
+			Bench.Actors.Add(Actor);
+
+			// Components are owned by the actor on creation, they do not need to be registered
+			for (int32 CompIdx = 0; CompIdx < Settings.NumComponents; ++CompIdx)
+			{
+				USceneComponent* Component = NewObject<USceneComponent>(Actor, NAME_None, RF_Transient);
+				BuildTags(ObjectIdx++, Settings.NumTags, Component->ComponentTags);
+				Bench.Components.Add(Component);
+			}
+		}
+		Bench.SampleTags = Bench.Actors.Num() > 0 ? Bench.Actors[0]->Tags : TArray<FName>();
+		return Bench;
+	}
+
+	// Destroy the synthetic world
+	void DestroyBenchWorld(FBenchWorld& Bench)
+	{
+		FTagIndex::Disable(Bench.World);
+		GEngine->DestroyWorldContext(Bench.World);
+		Bench.World->DestroyWorld(false);
+		Bench = FBenchWorld();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	// Times the cases and collects the results
+	class FBenchRunner
+	{
+	public:
+		FBenchRunner(const FBenchSettings& InSettings, FBenchWorld& InBench, FTagAllocCounter& InCounter, TArray<FBenchResult>& OutResults)
+			: Settings(InSettings), Bench(InBench), Counter(InCounter), Results(OutResults), bIndexed(false)
+		{}
+
+		// Set if the world index is enabled for the following cases
+		void SetIndexed(bool bInIndexed) { bIndexed = bInIndexed; }
+
+		// Run the functor NumOps times per repeat, keep the fastest repeat
+		template<typename FunctorType>
+		void Run(const TCHAR* Name, const TCHAR* Scope, int64 NumOps, FunctorType&& Functor)
+		{
+			double BestSeconds = TNumericLimits<double>::Max();
+			int64 BestAllocs = 0;
+			for (int32 Repeat = 0; Repeat < Settings.NumRepeats; ++Repeat)
+			{
+				Counter.Start();
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				for (int64 Op = 0; Op < NumOps; ++Op)
+				{
+					Functor(Op);
+				}
+				const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+				const int64 NumAllocs = Counter.Stop();
+				if (Seconds < BestSeconds)
+				{
+					BestSeconds = Seconds;
+					BestAllocs = NumAllocs;
+				}
+			}
+
+			FBenchResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Name;
+			Result.Scope = Scope;
+			Result.NumActors = Bench.Actors.Num();
+			Result.NumObjects = Bench.Actors.Num() + Bench.Components.Num();
+			Result.bIndexed = bIndexed;
+			Result.NumOps = NumOps;
+			Result.NsPerOp = NumOps > 0 ? BestSeconds * 1e9 / NumOps : 0.0;
+			Result.AllocsPerOp = NumOps > 0 ? double(BestAllocs) / NumOps : 0.0;
+			Result.PeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+		}
+
+		// Run the case once per actor
+		template<typename FunctorType>
+		void RunActors(const TCHAR* Name, FunctorType&& Functor)
+		{
+			Run(Name, TEXT("Actor"), Bench.Actors.Num(), [&](int64 Op) { Functor(Bench.Actors[Op]); });
+		}
+
+		// Run the case once per component
+		template<typename FunctorType>
+		void RunComponents(const TCHAR* Name, FunctorType&& Functor)
+		{
+			Run(Name, TEXT("Component"), Bench.Components.Num(), [&](int64 Op) { Functor(Bench.Components[Op]); });
+		}
+
+		// Run the case once per actor and component, passed as objects
+		template<typename FunctorType>
+		void RunObjects(const TCHAR* Name, FunctorType&& Functor)
+		{
+			const int32 NumActors = Bench.Actors.Num();
+			Run(Name, TEXT("Object"), NumActors + Bench.Components.Num(), [&](int64 Op)
+			{
+				UObject* Object = Op < NumActors ? static_cast<UObject*>(Bench.Actors[Op]) : Bench.Components[Op - NumActors];
+				Functor(Object);
+			});
+		}
+
+		// Run the world case a few times
+		template<typename FunctorType>
+		void RunWorld(const TCHAR* Name, FunctorType&& Functor)
+		{
+			Run(Name, TEXT("World"), 3, [&](int64) { Functor(Bench.World); });
+		}
+
+	private:
+		const FBenchSettings& Settings;
+		FBenchWorld& Bench;
+		FTagAllocCounter& Counter;
+		TArray<FBenchResult>& Results;
+		bool bIndexed;
+	};
+
+	// Cases on tags, arrays, actors, components and objects
+	void RunLocalCases(FBenchRunner& Runner, FBenchWorld& Bench)
+	{
+		const FName Tag = Bench.SampleTags.Num() > 0 ? Bench.SampleTags[0] : NAME_None;
+		const TArray<FName>& Tags = Bench.SampleTags;
+		const int64 NumTagOps = Bench.Actors.Num();
+		const FTagQuery Query(BenchType, BenchKey, BenchValue);
+		const TArray<TPair<FString, FString>> PairsArray = { TPair<FString, FString>(TEXT("Group"), TEXT("G1")), TPair<FString, FString>(TEXT("Extra"), TEXT("1")) };
+		TMap<FString, FString> PairsMap;
+		for (const auto& Pair : PairsArray)
+		{
+			PairsMap.Add(Pair.Key, Pair.Value);
+		}
+
+		// The object cases write back the values the objects already have, the tags end up unchanged
+		auto GetPairsArray = [](const TMap<FString, FString>& InPairs)
+		{
+			TArray<TPair<FString, FString>> OutPairs;
+			for (const auto& Pair : InPairs)
+			{
+				OutPairs.Emplace(Pair.Key, Pair.Value);
+			}
+			return OutPairs;
+		};
+
+		// Single tag
+		Runner.Run(TEXT("HasType"), TEXT("Tag"), NumTagOps, [&](int64) { FTags::HasType(Tag, BenchType); });
+		Runner.Run(TEXT("HasKey"), TEXT("Tag"), NumTagOps, [&](int64) { FTags::HasKey(Tag, BenchKey); });
+		Runner.Run(TEXT("HasKeyValuePair"), TEXT("Tag"), NumTagOps, [&](int64) { FTags::HasKeyValuePair(Tag, BenchKey, BenchValue); });
+		Runner.Run(TEXT("GetValue"), TEXT("Tag"), NumTagOps, [&](int64) { FTags::GetValue(Tag, BenchKey); });
+		Runner.Run(TEXT("AddKeyValuePair"), TEXT("Tag"), NumTagOps, [&](int64)
+		{
+			FName Copy = Tag;
+			FTags::AddKeyValuePair(Copy, TEXT("Group"), TEXT("G1"));
+		});
+		Runner.Run(TEXT("AddKeyValuePairs (array)"), TEXT("Tag"), NumTagOps, [&](int64)
+		{
+			FName Copy = Tag;
+			FTags::AddKeyValuePairs(Copy, PairsArray);
+		});
+		Runner.Run(TEXT("AddKeyValuePairs (map)"), TEXT("Tag"), NumTagOps, [&](int64)
+		{
+			FName Copy = Tag;
+			FTags::AddKeyValuePairs(Copy, PairsMap);
+		});
+		Runner.Run(TEXT("RemoveKeyValuePair"), TEXT("Tag"), NumTagOps, [&](int64)
+		{
+			FName Copy = Tag;
+			FTags::RemoveKeyValuePair(Copy, TEXT("Group"));
+		});
+
+		// Tags array
+		Runner.Run(TEXT("GetTagTypeIndex"), TEXT("Array"), NumTagOps, [&](int64) { FTags::GetTagTypeIndex(Tags, BenchType); });
+		Runner.Run(TEXT("HasType"), TEXT("Array"), NumTagOps, [&](int64) { FTags::HasType(Tags, BenchType); });
+		Runner.Run(TEXT("HasKey"), TEXT("Array"), NumTagOps, [&](int64) { FTags::HasKey(Tags, BenchType, BenchKey); });
+		Runner.Run(TEXT("HasKeyValuePair"), TEXT("Array"), NumTagOps, [&](int64) { FTags::HasKeyValuePair(Tags, BenchType, BenchKey, BenchValue); });
+		Runner.Run(TEXT("GetValue"), TEXT("Array"), NumTagOps, [&](int64) { FTags::GetValue(Tags, BenchType, BenchKey); });
+		Runner.Run(TEXT("GetKeyValuePairs"), TEXT("Array"), NumTagOps, [&](int64) { FTags::GetKeyValuePairs(Tags, BenchType); });
+		Runner.Run(TEXT("FTagQuery::Matches"), TEXT("Array"), NumTagOps, [&](int64) { Query.Matches(Tags); });
+		Runner.Run(TEXT("AddKeyValuePair"), TEXT("Array"), NumTagOps, [&](int64)
+		{
+			TArray<FName> Copy = Tags;
+			FTags::AddKeyValuePair(Copy, BenchType, TEXT("Group"), TEXT("G1"));
+		});
+		Runner.Run(TEXT("AddKeyValuePairs (array)"), TEXT("Array"), NumTagOps, [&](int64)
+		{
+			TArray<FName> Copy = Tags;
+			FTags::AddKeyValuePairs(Copy, BenchType, PairsArray);
+		});
+		Runner.Run(TEXT("AddKeyValuePairs (map)"), TEXT("Array"), NumTagOps, [&](int64)
+		{
+			TArray<FName> Copy = Tags;
+			FTags::AddKeyValuePairs(Copy, BenchType, PairsMap);
+		});
+		Runner.Run(TEXT("RemoveKeyValuePair"), TEXT("Array"), NumTagOps, [&](int64)
+		{
+			TArray<FName> Copy = Tags;
+			FTags::RemoveKeyValuePair(Copy, BenchType, TEXT("Group"));
+		});
+		Runner.Run(TEXT("AddTagType"), TEXT("Array"), NumTagOps, [&](int64)
+		{
+			TArray<FName> Copy = Tags;
+			FTags::AddTagType(Copy, TEXT("NewType"));
+		});
+
+		// Actors
+		Runner.RunActors(TEXT("GetTagTypeIndex"), [&](AActor* Act) { FTags::GetTagTypeIndex(Act, BenchType); });
+		Runner.RunActors(TEXT("HasType"), [&](AActor* Act) { FTags::HasType(Act, BenchType); });
+		Runner.RunActors(TEXT("HasKey"), [&](AActor* Act) { FTags::HasKey(Act, BenchType, BenchKey); });
+		Runner.RunActors(TEXT("HasKeyValuePair"), [&](AActor* Act) { FTags::HasKeyValuePair(Act, BenchType, BenchKey, BenchValue); });
+		Runner.RunActors(TEXT("GetValue"), [&](AActor* Act) { FTags::GetValue(Act, BenchType, BenchKey); });
+		Runner.RunActors(TEXT("GetKeyValuePairs"), [&](AActor* Act) { FTags::GetKeyValuePairs(Act, BenchType); });
+		Runner.RunActors(TEXT("FTagQuery::Matches"), [&](AActor* Act) { Query.Matches(Act); });
+		Runner.RunActors(TEXT("GetObjectTagsData"), [&](AActor* Act) { FTags::GetObjectTagsData(Act->Tags, Act); });
+		Runner.RunActors(TEXT("AddKeyValuePair (unchanged)"), [&](AActor* Act) { FTags::AddKeyValuePair(Act, BenchType, TEXT("Group"), FTags::GetValue(Act, BenchType, TEXT("Group"))); });
+		Runner.RunActors(TEXT("AddKeyValuePairs (array, unchanged)"), [&](AActor* Act) { FTags::AddKeyValuePairs(Act, BenchType, GetPairsArray(FTags::GetKeyValuePairs(Act, BenchType))); });
+		Runner.RunActors(TEXT("AddKeyValuePairs (map, unchanged)"), [&](AActor* Act) { FTags::AddKeyValuePairs(Act, BenchType, FTags::GetKeyValuePairs(Act, BenchType)); });
+		Runner.RunActors(TEXT("AddKeyValuePair + RemoveKeyValuePair"), [&](AActor* Act)
+		{
+			FTags::AddKeyValuePair(Act, BenchType, TEXT("Tmp"), TEXT("1"));
+			FTags::RemoveKeyValuePair(Act, BenchType, TEXT("Tmp"));
+		});
+		Runner.RunActors(TEXT("AddTagType (existing)"), [&](AActor* Act) { FTags::AddTagType(Act, BenchType); });
+
+		// Components
+		Runner.RunComponents(TEXT("GetTagTypeIndex"), [&](UActorComponent* Comp) { FTags::GetTagTypeIndex(Comp, BenchType); });
+		Runner.RunComponents(TEXT("HasType"), [&](UActorComponent* Comp) { FTags::HasType(Comp, BenchType); });
+		Runner.RunComponents(TEXT("HasKey"), [&](UActorComponent* Comp) { FTags::HasKey(Comp, BenchType, BenchKey); });
+		Runner.RunComponents(TEXT("HasKeyValuePair"), [&](UActorComponent* Comp) { FTags::HasKeyValuePair(Comp, BenchType, BenchKey, BenchValue); });
+		Runner.RunComponents(TEXT("GetValue"), [&](UActorComponent* Comp) { FTags::GetValue(Comp, BenchType, BenchKey); });
+		Runner.RunComponents(TEXT("GetKeyValuePairs"), [&](UActorComponent* Comp) { FTags::GetKeyValuePairs(Comp, BenchType); });
+		Runner.RunComponents(TEXT("FTagQuery::Matches"), [&](UActorComponent* Comp) { Query.Matches(Comp); });
+		Runner.RunComponents(TEXT("GetObjectTagsData"), [&](UActorComponent* Comp) { FTags::GetObjectTagsData(Comp->ComponentTags, Comp); });
+		Runner.RunComponents(TEXT("AddKeyValuePair (unchanged)"), [&](UActorComponent* Comp) { FTags::AddKeyValuePair(Comp, BenchType, TEXT("Group"), FTags::GetValue(Comp, BenchType, TEXT("Group"))); });
+		Runner.RunComponents(TEXT("AddKeyValuePairs (array, unchanged)"), [&](UActorComponent* Comp) { FTags::AddKeyValuePairs(Comp, BenchType, GetPairsArray(FTags::GetKeyValuePairs(Comp, BenchType))); });
+		Runner.RunComponents(TEXT("AddKeyValuePairs (map, unchanged)"), [&](UActorComponent* Comp) { FTags::AddKeyValuePairs(Comp, BenchType, FTags::GetKeyValuePairs(Comp, BenchType)); });
+		Runner.RunComponents(TEXT("AddKeyValuePair + RemoveKeyValuePair"), [&](UActorComponent* Comp)
+		{
+			FTags::AddKeyValuePair(Comp, BenchType, TEXT("Tmp"), TEXT("1"));
+			FTags::RemoveKeyValuePair(Comp, BenchType, TEXT("Tmp"));
+		});
+		Runner.RunComponents(TEXT("AddTagType (existing)"), [&](UActorComponent* Comp) { FTags::AddTagType(Comp, BenchType); });
+
+		// Objects
+		Runner.RunObjects(TEXT("GetTagTypeIndex"), [&](UObject* Obj) { FTags::GetTagTypeIndex(Obj, BenchType); });
+		Runner.RunObjects(TEXT("HasType"), [&](UObject* Obj) { FTags::HasType(Obj, BenchType); });
+		Runner.RunObjects(TEXT("HasKey"), [&](UObject* Obj) { FTags::HasKey(Obj, BenchType, BenchKey); });
+		Runner.RunObjects(TEXT("HasKeyValuePair"), [&](UObject* Obj) { FTags::HasKeyValuePair(Obj, BenchType, BenchKey, BenchValue); });
+		Runner.RunObjects(TEXT("GetValue"), [&](UObject* Obj) { FTags::GetValue(Obj, BenchType, BenchKey); });
+		Runner.RunObjects(TEXT("GetKeyValuePairs"), [&](UObject* Obj) { FTags::GetKeyValuePairs(Obj, BenchType); });
+		Runner.RunObjects(TEXT("AddKeyValuePair (unchanged)"), [&](UObject* Obj) { FTags::AddKeyValuePair(Obj, BenchType, TEXT("Group"), FTags::GetValue(Obj, BenchType, TEXT("Group"))); });
+		Runner.RunObjects(TEXT("AddKeyValuePairs (array, unchanged)"), [&](UObject* Obj) { FTags::AddKeyValuePairs(Obj, BenchType, GetPairsArray(FTags::GetKeyValuePairs(Obj, BenchType))); });
+		Runner.RunObjects(TEXT("AddKeyValuePairs (map, unchanged)"), [&](UObject* Obj) { FTags::AddKeyValuePairs(Obj, BenchType, FTags::GetKeyValuePairs(Obj, BenchType)); });
+		Runner.RunObjects(TEXT("AddTagType (existing)"), [&](UObject* Obj) { FTags::AddTagType(Obj, BenchType); });
+	}
+
+	// Build a tag of exactly the given length with many short pairs
+	FString BuildLongTag(int32 Len)
+	{
+		FString Tag = TEXT("Long;");
+		for (int32 PairIdx = 0; Tag.Len() < Len; ++PairIdx)
+		{
+			Tag += FString::Printf(TEXT("Key%d,Value%d;"), PairIdx, PairIdx);
+		}
+		return Tag.Left(Len);
+	}
+
+	// Delimiter scanning and full tag splitting, scalar and vectorized, on 64, 256 and 1024 character tags
+	void RunScanCases(FBenchRunner& Runner)
+	{
+		const int64 NumOps = 100000;
+		for (const int32 Len : { 64, 256, 1024 })
+		{
+			const FString Tag = BuildLongTag(Len);
+			const FTagView View(Tag);
+			const FString Scope = FString::Printf(TEXT("Tag%d"), Len);
+			FTagDelimiterScan::FOffsets Offsets;
+
+			Runner.Run(TEXT("ScanScalar"), *Scope, NumOps, [&](int64)
+			{
+				Offsets.Reset();
+				FTagDelimiterScan::ScanScalar(View.Data, 0, View.Len, Offsets);
+			});
+			Runner.Run(FTagDelimiterScan::IsVectorized() ? TEXT("Scan (SSE2)") : TEXT("Scan (scalar fallback)"), *Scope, NumOps, [&](int64)
+			{
+				Offsets.Reset();
+				FTagDelimiterScan::Scan(View, Offsets);
+			});
+			Runner.Run(TEXT("FTagTokenizer all pairs"), *Scope, NumOps, [&](int64)
+			{
+				FTagTokenizer Tokenizer(View);
+				FTagView Key, Value;
+				while (Tokenizer.Next(Key, Value)) {}
+			});
+			Runner.Run(TEXT("FTagSplitter all pairs"), *Scope, NumOps, [&](int64)
+			{
+				FTagSplitter Splitter(View);
+				FTagView Key, Value;
+				while (Splitter.Next(Key, Value)) {}
+			});
+		}
+	}
+
+	// Cases on the whole world
+	void RunWorldCases(FBenchRunner& Runner)
+	{
+		const FTagQuery Query(BenchType, BenchKey, BenchValue);
+		const TSet<FString> Types = { BenchType, TEXT("Extra1") };
+
+		Runner.RunWorld(TEXT("GetObjectKeyValuePairsMap"), [&](UWorld* World) { FTags::GetObjectKeyValuePairsMap(World, BenchType); });
+		Runner.RunWorld(TEXT("GetActorsToKeyValuePairs"), [&](UWorld* World) { FTags::GetActorsToKeyValuePairs(World, BenchType); });
+		Runner.RunWorld(TEXT("GetComponentsToKeyValuePairs"), [&](UWorld* World) { FTags::GetComponentsToKeyValuePairs(World, BenchType); });
+		Runner.RunWorld(TEXT("GetObjectKeyValuePairsMaps"), [&](UWorld* World) { FTags::GetObjectKeyValuePairsMaps(World, Types); });
+		Runner.RunWorld(TEXT("GetObjectsIdToKeyValue"), [&](UWorld* World) { FTags::GetObjectsIdToKeyValue(World, BenchType, BenchKey); });
+		Runner.RunWorld(TEXT("GetObjectsToKeyValue"), [&](UWorld* World) { FTags::GetObjectsToKeyValue(World, BenchType, BenchKey); });
+		Runner.RunWorld(TEXT("GetActorsToKeyValue"), [&](UWorld* World) { FTags::GetActorsToKeyValue(World, BenchType, BenchKey); });
+		Runner.RunWorld(TEXT("GetComponentsToKeyValue"), [&](UWorld* World) { FTags::GetComponentsToKeyValue(World, BenchType, BenchKey); });
+		Runner.RunWorld(TEXT("GetKeyValuesToObject"), [&](UWorld* World) { FTags::GetKeyValuesToObject(World, BenchType, BenchKey); });
+		Runner.RunWorld(TEXT("GetKeyValuesToActor"), [&](UWorld* World) { FTags::GetKeyValuesToActor(World, BenchType, BenchKey); });
+		Runner.RunWorld(TEXT("GetKeyValuesToComponents"), [&](UWorld* World) { FTags::GetKeyValuesToComponents(World, BenchType, BenchKey); });
+		Runner.RunWorld(TEXT("GetActorsWithKeyValuePair"), [&](UWorld* World) { FTags::GetActorsWithKeyValuePair(World, BenchType, BenchKey, BenchValue); });
+		Runner.RunWorld(TEXT("GetActorsWithKeyValuePairAsSet"), [&](UWorld* World) { FTags::GetActorsWithKeyValuePairAsSet(World, BenchType, BenchKey, BenchValue); });
+		Runner.RunWorld(TEXT("GetComponentsWithKeyValuePair"), [&](UWorld* World) { FTags::GetComponentsWithKeyValuePair(World, BenchType, BenchKey, BenchValue); });
+		Runner.RunWorld(TEXT("GetComponentsWithKeyValuePairAsSet"), [&](UWorld* World) { FTags::GetComponentsWithKeyValuePairAsSet(World, BenchType, BenchKey, BenchValue); });
+		Runner.RunWorld(TEXT("GetActorSetWithKeyValuePair"), [&](UWorld* World) { FTags::GetActorSetWithKeyValuePair(World, BenchType, BenchKey, BenchValue); });
+		Runner.RunWorld(TEXT("GetComponentSetWithKeyValuePair"), [&](UWorld* World) { FTags::GetComponentSetWithKeyValuePair(World, BenchType, BenchKey, BenchValue); });
+		Runner.RunWorld(TEXT("GetActorsWithKeyValuePair (query)"), [&](UWorld* World) { FTags::GetActorsWithKeyValuePair(World, Query); });
+		Runner.RunWorld(TEXT("FindFirstObjectWithKeyValuePair"), [&](UWorld* World) { FTags::FindFirstObjectWithKeyValuePair(World, BenchType, BenchKey, BenchValue); });
+		Runner.RunWorld(TEXT("ForEachObjectWithTag"), [&](UWorld* World) { FTags::ForEachObjectWithTag(World, BenchType, BenchKey, [](UObject*, const FTagView&) { return true; }); });
+		Runner.RunWorld(TEXT("GetWorldTagsData"), [&](UWorld* World) { FTags::GetWorldTagsData(World); });
+		Runner.RunWorld(TEXT("GetObjectKeyValuePairsMapParallel"), [&](UWorld* World) { FTags::GetObjectKeyValuePairsMapParallel(World, BenchType); });
+		Runner.RunWorld(TEXT("GetWorldTagsDataParallel"), [&](UWorld* World) { FTags::GetWorldTagsDataParallel(World); });
+
+		// Mutates the world, the key is not carried by the objects so every run does the same work
+		Runner.RunWorld(TEXT("RemoveAllKeyValuePairs (missing key)"), [&](UWorld* World) { FTags::RemoveAllKeyValuePairs(World, BenchType, TEXT("Missing")); });
+	}
+
+	// Write the results as comma separated values
+	FString WriteCsv(const TArray<FBenchResult>& Results)
+	{
+		FString Csv = TEXT("Case,Scope,NumActors,NumObjects,Indexed,NumOps,NsPerOp,AllocsPerOp,PeakUsedPhysicalMB\n");
+		for (const auto& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("\"%s\",%s,%d,%d,%d,%lld,%.2f,%.3f,%.1f\n"),
+				*Result.Name, *Result.Scope, Result.NumActors, Result.NumObjects, Result.bIndexed ? 1 : 0,
+				Result.NumOps, Result.NsPerOp, Result.AllocsPerOp, Result.PeakUsedPhysical / (1024.0 * 1024.0));
+		}
+
+		const FString Filename = FPaths::ProjectSavedDir() / TEXT("UTags") /
+			FString::Printf(TEXT("Benchmark_%s.csv"), *FDateTime::Now().ToString());
+		FFileHelper::SaveStringToFile(Csv, *Filename);
+		return Filename;
+	}
+
+	// Parse the arguments and run the benchmark
+	void RunBenchmark(const TArray<FString>& Args)
+	{
+		FBenchSettings Settings;
+		const FString ArgsString = FString::Join(Args, TEXT(" "));
+		FString ActorsString = TEXT("1000,10000,100000");
+		FParse::Value(*ArgsString, TEXT("Actors="), ActorsString);
+		FParse::Value(*ArgsString, TEXT("Components="), Settings.NumComponents);
+		FParse::Value(*ArgsString, TEXT("Tags="), Settings.NumTags);
+		FParse::Value(*ArgsString, TEXT("Repeats="), Settings.NumRepeats);
+		Settings.NumTags = FMath::Max(Settings.NumTags, 1);
+		Settings.NumRepeats = FMath::Max(Settings.NumRepeats, 1);
+
+		TArray<FString> ActorsStrings;
+		ActorsString.ParseIntoArray(ActorsStrings, TEXT(","));
+		for (const auto& Str : ActorsStrings)
+		{
+			Settings.NumActors.Add(FCString::Atoi(*Str));
+		}
+
+		// Installed from the game thread for the benchmark run only, counts the allocations of this thread only
+		FTagAllocCounterScope CounterScope;
+		FTagAllocCounter* Counter = CounterScope.Get();
+		if (Counter == nullptr)
+		{
+			return;
+		}
+
+		TArray<FBenchResult> Results;
+		for (const int32 NumActors : Settings.NumActors)
+		{
+			UE_LOG(LogTags, Display, TEXT("%s::%d Benchmarking %d actors with %d components and %d tags each.."),
+				*FString(__func__), __LINE__, NumActors, Settings.NumComponents, Settings.NumTags);
+
+			FBenchWorld Bench = CreateBenchWorld(NumActors, Settings);
+			FBenchRunner Runner(Settings, Bench, *Counter, Results);
+			RunLocalCases(Runner, Bench);
+			if (NumActors == Settings.NumActors[0])
+			{
+				// Independent of the world size
+				RunScanCases(Runner);
+			}
+			RunWorldCases(Runner);
+
+			// Same world queries answered by the tag index
+			FTagIndex::Enable(Bench.World);
+			Runner.SetIndexed(true);
+			RunWorldCases(Runner);
+
+			DestroyBenchWorld(Bench);
+		}
+
+		const FString Filename = WriteCsv(Results);
+		UE_LOG(LogTags, Display, TEXT("%s::%d Wrote %d results to %s"), *FString(__func__), __LINE__, Results.Num(), *Filename);
+	}
+
+	FAutoConsoleCommand BenchmarkCommand(
+		TEXT("UTags.Benchmark"),
+		TEXT("Benchmark the FTags functions on synthetic worlds: UTags.Benchmark [Actors=1000,10000,100000] [Components=2] [Tags=2] [Repeats=3]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmark));
+}
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,77 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagDelimiterScan.h"
+
+// SSE2 is part of every x64 target and of the x86 targets compiled with it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTAGS_SSE2_SCAN 1
+#include <emmintrin.h>
+#else
+#define UTAGS_SSE2_SCAN 0
+#endif
+
+// Append the offsets of the delimiters of the text
+void FTagDelimiterScan::Scan(const FTagView& InText, FOffsets& OutOffsets)
+{
+	int32 Idx = 0;
+#if UTAGS_SSE2_SCAN
+	if (sizeof(TCHAR) == 2)
+	{
+		const __m128i Semicolons = _mm_set1_epi16(TEXT(';'));
+		const __m128i Commas = _mm_set1_epi16(TEXT(','));
+		for (; Idx + 8 <= InText.Len; Idx += 8)
+		{
+			const __m128i Chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(InText.Data + Idx));
+			const __m128i Matches = _mm_or_si128(_mm_cmpeq_epi16(Chars, Semicolons), _mm_cmpeq_epi16(Chars, Commas));
+
+			// Two mask bits per matching character
+			uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(Matches));
+			while (Mask != 0)
+			{
+				const uint32 Bit = FMath::CountTrailingZeros(Mask);
+				OutOffsets.Add(Idx + Bit / 2);
+				Mask &= ~(3u << Bit);
+			}
+		}
+	}
+	else if (sizeof(TCHAR) == 4)
+	{
+		const __m128i Semicolons = _mm_set1_epi32(TEXT(';'));
+		const __m128i Commas = _mm_set1_epi32(TEXT(','));
+		for (; Idx + 4 <= InText.Len; Idx += 4)
+		{
+			const __m128i Chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(InText.Data + Idx));
+			const __m128i Matches = _mm_or_si128(_mm_cmpeq_epi32(Chars, Semicolons), _mm_cmpeq_epi32(Chars, Commas));
+
+			// Four mask bits per matching character
+			uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(Matches));
+			while (Mask != 0)
+			{
+				const uint32 Bit = FMath::CountTrailingZeros(Mask);
+				OutOffsets.Add(Idx + Bit / 4);
+				Mask &= ~(15u << Bit);
+			}
+		}
+	}
+#endif
+	ScanScalar(InText.Data, Idx, InText.Len, OutOffsets);
+}
+
+// Append the offsets of the delimiters in [Start, End) character by character
+void FTagDelimiterScan::ScanScalar(const TCHAR* Data, int32 Start, int32 End, FOffsets& OutOffsets)
+{
+	for (int32 Idx = Start; Idx < End; ++Idx)
+	{
+		if (Data[Idx] == TEXT(';') || Data[Idx] == TEXT(','))
+		{
+			OutOffsets.Add(Idx);
+		}
+	}
+}
+
+// Check if the vectorized scan is compiled in for the TCHAR size of the platform
+bool FTagDelimiterScan::IsVectorized()
+{
+	return UTAGS_SSE2_SCAN && (sizeof(TCHAR) == 2 || sizeof(TCHAR) == 4);
+}
@@ -0,0 +1,356 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagEditor.h"
+#include "TagTokenizer.h"
+#include "TagStore.h"
+
+// Edit a tags array, the owner (if any) is modified and notified on commit
+FTagEditor::FTagEditor(TArray<FName>& InTags, UObject* InOwner)
+	: Tags(&InTags), SingleTag(nullptr), Owner(InOwner)
+{
+	// Pending tag store values are written first, the edits apply on top of them
+	FlushStore();
+	Entries.SetNum(InTags.Num());
+}
+
+// Edit a single tag, the operations apply to the type of the tag
+FTagEditor::FTagEditor(FName& InTag, UObject* InOwner)
+	: Tags(nullptr), SingleTag(&InTag), Owner(InOwner)
+{
+	FlushStore();
+	Entries.SetNum(1);
+}
+
+// Edit the tags of the actor
+FTagEditor::FTagEditor(AActor* Actor) : FTagEditor(Actor->Tags, Actor)
+{
+}
+
+// Edit the tags of the component
+FTagEditor::FTagEditor(UActorComponent* Component) : FTagEditor(Component->ComponentTags, Component)
+{
+}
+
+// Write the pending tag store values of the owner to its tags
+void FTagEditor::FlushStore()
+{
+	if (Owner)
+	{
+		if (FTagStore* Store = FTagStore::Get())
+		{
+			Store->Flush(Owner);
+		}
+	}
+}
+
+// Return the index of the first tag of the given type, INDEX_NONE if not found
+int32 FTagEditor::FindTagType(const FString& TagType) const
+{
+	for (int32 TagIndex = 0; TagIndex < Entries.Num(); ++TagIndex)
+	{
+		const FEntry& Entry = Entries[TagIndex];
+		if (Entry.bParsed)
+		{
+			if (Entry.bHasType && Entry.TagType == TagType)
+			{
+				return TagIndex;
+			}
+		}
+		else
+		{
+			// Check the type without parsing the tag
+			FTagNameBuffer TagBuffer(GetSourceTag(TagIndex));
+			if (FTagTokenizer(TagBuffer.GetView()).IsType(TagType))
+			{
+				return TagIndex;
+			}
+		}
+	}
+	return INDEX_NONE;
+}
+
+// Add a new tag of the given type, false if the type already exists
+bool FTagEditor::AddTagType(const FString& TagType)
+{
+	// New tags can only be added to arrays
+	if (Tags == nullptr || FindTagType(TagType) != INDEX_NONE)
+	{
+		return false;
+	}
+
+	FEntry& NewEntry = Entries.AddDefaulted_GetRef();
+	NewEntry.TagType = TagType;
+	NewEntry.bParsed = true;
+	NewEntry.bHasType = true;
+	NewEntry.bDirty = true;
+	NewEntry.bNew = true;
+	return true;
+}
+
+// Add key value pair to the tag type (the tag is created if needed), if bReplaceExisting is true, replace existing value
+bool FTagEditor::AddKeyValuePair(const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting)
+{
+	int32 TagIndex = FindTagType(TagType);
+	if (TagIndex == INDEX_NONE)
+	{
+		// Type was not found, create a new one
+		if (!AddTagType(TagType))
+		{
+			return false;
+		}
+		TagIndex = Entries.Num() - 1;
+	}
+	return AddKeyValuePair(TagIndex, TagKey, TagValue, bReplaceExisting);
+}
+
+// Add key value pair to the tag at the given index, if bReplaceExisting is true, replace existing value
+bool FTagEditor::AddKeyValuePair(int32 TagIndex, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting)
+{
+	if (!Entries.IsValidIndex(TagIndex))
+	{
+		return false;
+	}
+
+	FEntry& Entry = GetParsedEntry(TagIndex);
+	if (!Entry.bHasType)
+	{
+		return false;
+	}
+
+	FPair* Existing = Entry.Pairs.FindByPredicate([&TagKey](const FPair& Pair)
+	{
+		return Pair.bHasValue && Pair.Key == TagKey;
+	});
+
+	// Key does not exist (or has no value), add new one at the end
+	if (Existing == nullptr || Existing->Value.IsEmpty())
+	{
+		if (Existing)
+		{
+			Existing->Value.Reset();
+			Existing->Value.AppendChars(TagValue.Data, TagValue.Len);
+		}
+		else
+		{
+			Entry.Pairs.Add(FPair{ TagKey, TagValue.ToString(), true });
+		}
+		Entry.bDirty = true;
+		return true;
+	}
+	else if (bReplaceExisting)
+	{
+		// Key exists, replace (the tag only changes if the value differs)
+		if (!FTagView(Existing->Value).Equals(TagValue, ESearchCase::CaseSensitive))
+		{
+			Existing->Value.Reset();
+			Existing->Value.AppendChars(TagValue.Data, TagValue.Len);
+			Entry.bDirty = true;
+		}
+		return true;
+	}
+	// Cannot overwrite value, return false
+	return false;
+}
+
+// Remove key value pair from the tag type
+bool FTagEditor::RemoveKeyValuePair(const FString& TagType, const FString& TagKey)
+{
+	return RemoveKeyValuePair(FindTagType(TagType), TagKey);
+}
+
+// Remove key value pair from the tag at the given index
+bool FTagEditor::RemoveKeyValuePair(int32 TagIndex, const FString& TagKey)
+{
+	if (!Entries.IsValidIndex(TagIndex))
+	{
+		return false;
+	}
+
+	FEntry& Entry = GetParsedEntry(TagIndex);
+	const int32 PairIndex = Entry.Pairs.IndexOfByPredicate([&TagKey](const FPair& Pair)
+	{
+		return Pair.bHasValue && Pair.Key == TagKey;
+	});
+	if (PairIndex != INDEX_NONE)
+	{
+		Entry.Pairs.RemoveAt(PairIndex);
+		Entry.bDirty = true;
+		return true;
+	}
+	// "TagKey,TagValue;" combo could not be found
+	return false;
+}
+
+// Get the (edited) value of the key of the tag type, empty if not found
+FString FTagEditor::GetValue(const FString& TagType, const FString& TagKey) const
+{
+	const int32 TagIndex = FindTagType(TagType);
+	if (TagIndex == INDEX_NONE)
+	{
+		return FString();
+	}
+
+	const FEntry& Entry = Entries[TagIndex];
+	if (!Entry.bParsed)
+	{
+		FTagNameBuffer TagBuffer(GetSourceTag(TagIndex));
+		FTagView Value;
+		return FTagTokenizer(TagBuffer.GetView()).FindValue(TagKey, Value) ? Value.ToString() : FString();
+	}
+
+	for (const auto& Pair : Entry.Pairs)
+	{
+		if (Pair.bHasValue && Pair.Key == TagKey)
+		{
+			return Pair.Value;
+		}
+	}
+	return FString();
+}
+
+// Check if there are uncommitted changes
+bool FTagEditor::HasChanges() const
+{
+	return Entries.ContainsByPredicate([](const FEntry& Entry) { return Entry.bDirty; });
+}
+
+// Write the changed tags, returns the number of written tags
+int32 FTagEditor::Commit()
+{
+	if (!HasChanges())
+	{
+		return 0;
+	}
+
+	if (Owner)
+	{
+		Owner->Modify();
+	}
+
+	int32 NumWritten = 0;
+	for (int32 TagIndex = 0; TagIndex < Entries.Num(); ++TagIndex)
+	{
+		FEntry& Entry = Entries[TagIndex];
+		if (!Entry.bDirty)
+		{
+			continue;
+		}
+
+		// One new name per changed tag
+		const FName NewTag(*ToTagString(Entry));
+		if (SingleTag)
+		{
+			*SingleTag = NewTag;
+		}
+		else if (Entry.bNew)
+		{
+			Tags->Add(NewTag);
+			Entry.bNew = false;
+		}
+		else
+		{
+			(*Tags)[TagIndex] = NewTag;
+		}
+		Entry.bDirty = false;
+		++NumWritten;
+	}
+
+	if (Owner)
+	{
+		FTags::OnTagsChanged().Broadcast(Owner);
+	}
+	return NumWritten;
+}
+
+// Drop the uncommitted changes
+void FTagEditor::Discard()
+{
+	Entries.Reset();
+	Entries.SetNum(NumSourceTags());
+}
+
+// Number of tags in the edited source
+int32 FTagEditor::NumSourceTags() const
+{
+	return SingleTag ? 1 : Tags->Num();
+}
+
+// Get the source tag at the given index
+const FName& FTagEditor::GetSourceTag(int32 TagIndex) const
+{
+	return SingleTag ? *SingleTag : (*Tags)[TagIndex];
+}
+
+// Parse the tag on its first edit
+FTagEditor::FEntry& FTagEditor::GetParsedEntry(int32 TagIndex)
+{
+	FEntry& Entry = Entries[TagIndex];
+	if (Entry.bParsed)
+	{
+		return Entry;
+	}
+	Entry.bParsed = true;
+
+	FTagNameBuffer TagBuffer(GetSourceTag(TagIndex));
+	const FTagView Tag = TagBuffer.GetView();
+	const int32 TypeEnd = Tag.Find(TEXT(';'));
+	if (TypeEnd == INDEX_NONE)
+	{
+		// Untyped tags are never edited
+		return Entry;
+	}
+	Entry.bHasType = true;
+	Entry.TagType = FTagView(Tag.Data, TypeEnd).ToString();
+
+	// Split the segments on semicolon, keep the malformed ones as they are
+	int32 SegmentStart = TypeEnd + 1;
+	while (SegmentStart < Tag.Len)
+	{
+		int32 SegmentEnd = Tag.Find(TEXT(';'), SegmentStart);
+		if (SegmentEnd == INDEX_NONE)
+		{
+			SegmentEnd = Tag.Len;
+		}
+
+		const FTagView Segment(Tag.Data + SegmentStart, SegmentEnd - SegmentStart);
+		if (!Segment.IsEmpty())
+		{
+			const int32 Comma = Segment.Find(TEXT(','));
+			if (Comma != INDEX_NONE)
+			{
+				Entry.Pairs.Add(FPair{ FTagView(Segment.Data, Comma).ToString(), FTagView(Segment.Data + Comma + 1, Segment.Len - Comma - 1).ToString(), true });
+			}
+			else
+			{
+				Entry.Pairs.Add(FPair{ Segment.ToString(), FString(), false });
+			}
+		}
+		SegmentStart = SegmentEnd + 1;
+	}
+	return Entry;
+}
+
+// Build the tag string of the entry
+FString FTagEditor::ToTagString(const FEntry& Entry)
+{
+	int32 Len = Entry.TagType.Len() + 1;
+	for (const auto& Pair : Entry.Pairs)
+	{
+		Len += Pair.Key.Len() + Pair.Value.Len() + 2;
+	}
+
+	FString TagString;
+	TagString.Reserve(Len);
+	TagString.Append(Entry.TagType).AppendChar(TEXT(';'));
+	for (const auto& Pair : Entry.Pairs)
+	{
+		TagString.Append(Pair.Key);
+		if (Pair.bHasValue)
+		{
+			TagString.AppendChar(TEXT(',')).Append(Pair.Value);
+		}
+		TagString.AppendChar(TEXT(';'));
+	}
+	return TagString;
+}
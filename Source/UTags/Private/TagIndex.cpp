@@ -0,0 +1,1002 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagIndex.h"
+#include "TagParseCache.h"
+#include "TagStore.h"
+#include "TagActorWatcher.h"
+#include "TagValue.h"
+#include "UTags.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	// Parse the tags into one tag data entry per tag type, merging the pairs of the tags of the same type (same as FTags::GetKeyValuePairs),
+	// if a type has more than one tag, the first tag of each type is also returned (same as FTags::GetValue)
+	void ParseTagsData(const TArray<FName>& InTags, TArray<FTagData>& OutTagsData, TArray<FTagData>& OutFirstTagsData)
+	{
+		TArray<FTagParseCache::FTagDataRef, TInlineAllocator<8>> FirstTags;
+		bool bRepeatedType = false;
+		for (const auto& TagItr : InTags)
+		{
+			const FTagParseCache::FTagDataRef Parsed = FTagParseCache::Get().GetTagData(TagItr);
+			if (Parsed->TagType.IsEmpty())
+			{
+				continue;
+			}
+
+			// Merge the pairs of tags with the same type
+			FTagData* TagData = OutTagsData.FindByPredicate([&Parsed](const FTagData& Data) { return Data.TagType == Parsed->TagType; });
+			if (TagData == nullptr)
+			{
+				OutTagsData.Add(*Parsed);
+				FirstTags.Add(Parsed);
+			}
+			else
+			{
+				TagData->KeyValueMap.Append(Parsed->KeyValueMap);
+				bRepeatedType = true;
+			}
+		}
+
+		if (bRepeatedType)
+		{
+			for (const auto& Parsed : FirstTags)
+			{
+				OutFirstTagsData.Add(*Parsed);
+			}
+		}
+	}
+}
+
+// Create and build the index of the world (returns the existing one if already enabled)
+FTagIndex* FTagIndex::Enable(UWorld* World)
+{
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (FTagIndex* Existing = Get(World))
+	{
+		return Existing;
+	}
+
+	// Drop the indices of the worlds which are cleaned up
+	static bool bWorldCleanupRegistered = false;
+	if (!bWorldCleanupRegistered)
+	{
+		FWorldDelegates::OnWorldCleanup.AddStatic(&FTagIndex::OnWorldCleanup);
+		bWorldCleanupRegistered = true;
+	}
+
+	FTagIndex* NewIndex = new FTagIndex(World);
+	GetWorldIndices().Emplace(World, TUniquePtr<FTagIndex>(NewIndex));
+	NewIndex->Rebuild();
+	return NewIndex;
+}
+
+// Remove the index of the world
+void FTagIndex::Disable(UWorld* World)
+{
+	GetWorldIndices().Remove(World);
+}
+
+// Get the index of the world, nullptr if it is not enabled
+FTagIndex* FTagIndex::Get(UWorld* World)
+{
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+	if (TUniquePtr<FTagIndex>* Index = GetWorldIndices().Find(World))
+	{
+		return Index->Get();
+	}
+	return nullptr;
+}
+
+// Register to the world and engine events
+FTagIndex::FTagIndex(UWorld* InWorld) : World(InWorld)
+{
+	ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateRaw(this, &FTagIndex::OnActorSpawned));
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FTagIndex::OnActorSpawned);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FTagIndex::OnActorDeleted);
+	}
+	// Editor deletions only notify the engine, destroyed game actors notify their OnDestroyed
+	ActorDestroyedHandle = UTagActorWatcher::OnActorDestroyed().AddRaw(this, &FTagIndex::OnActorDeleted);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FTagIndex::OnPostGarbageCollect);
+	TagsChangedHandle = FTags::OnTagsChanged().AddRaw(this, &FTagIndex::OnTagsChanged);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FTagIndex::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FTagIndex::OnLevelRemoved);
+}
+
+// Unregister from the world and engine events
+FTagIndex::~FTagIndex()
+{
+	if (UWorld* IndexedWorld = World.Get())
+	{
+		IndexedWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+	UTagActorWatcher::OnActorDestroyed().Remove(ActorDestroyedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	FTags::OnTagsChanged().Remove(TagsChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+}
+
+// Clear and re-index all the actors and components of the world
+void FTagIndex::Rebuild()
+{
+	Entries.Empty();
+	TypeToObjects.Empty();
+	ObjectTags.Empty();
+	FirstTagsOfType.Empty();
+	LevelObjects.Empty();
+	ObjectLevels.Empty();
+
+	// Keep the built numeric keys, their values are added again while re-indexing
+	for (auto& TypeToKeys : NumericIndices)
+	{
+		for (auto& KeyToValues : TypeToKeys.Value)
+		{
+			KeyToValues.Value.Empty();
+		}
+	}
+
+	for (auto& TypeToKeys : SortedValueIndices)
+	{
+		for (auto& KeyToValues : TypeToKeys.Value)
+		{
+			KeyToValues.Value.Values.Empty();
+			KeyToValues.Value.ReversedValues.Empty();
+		}
+	}
+
+	// Keep the identity keys, their duplicates are found again while re-indexing
+	for (auto& TypeToKeys : IdentityKeys)
+	{
+		for (auto& KeyToDuplicates : TypeToKeys.Value)
+		{
+			KeyToDuplicates.Value.Empty();
+		}
+	}
+
+	// Index the persistent and the visible streamed levels
+	if (UWorld* IndexedWorld = World.Get())
+	{
+		for (ULevel* Level : IndexedWorld->GetLevels())
+		{
+			if (Level && (Level->bIsVisible || Level == IndexedWorld->PersistentLevel))
+			{
+				AddLevel(Level);
+			}
+		}
+	}
+}
+
+// (Re)index the tags of the actor and of its components, or of the component
+void FTagIndex::AddObject(UObject* Object)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		AddSingleObject(Actor, Actor->Tags);
+		for (const auto& CompItr : Actor->GetComponents())
+		{
+			AddSingleObject(CompItr, CompItr->ComponentTags);
+		}
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		AddSingleObject(Component, Component->ComponentTags);
+	}
+}
+
+// Remove the actor and its components, or the component, from the index
+void FTagIndex::RemoveObject(UObject* Object)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		for (const auto& CompItr : Actor->GetComponents())
+		{
+			RemoveSingleObject(CompItr);
+		}
+	}
+	RemoveSingleObject(Object);
+}
+
+// Remove the destroyed objects (done after every garbage collection), returns the number of removed objects
+int32 FTagIndex::Compact()
+{
+	TArray<TWeakObjectPtr<UObject>> Destroyed;
+	for (const auto& ObjectToTags : ObjectTags)
+	{
+		if (!ObjectToTags.Key.IsValid())
+		{
+			Destroyed.Add(ObjectToTags.Key);
+		}
+	}
+	for (const auto& ObjPtr : Destroyed)
+	{
+		RemoveSingleObject(ObjPtr);
+	}
+	return Destroyed.Num();
+}
+
+// Index the actors and components of the level (done when the level is added to the world)
+void FTagIndex::AddLevel(ULevel* Level)
+{
+	if (Level == nullptr)
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor && !Actor->IsPendingKill())
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			AddObject(Actor);
+		}
+	}
+}
+
+// Remove the objects of the level partition (done when the level is removed from the world)
+void FTagIndex::RemoveLevel(ULevel* Level)
+{
+	RemoveLevelPartition(Level);
+}
+
+// Remove the objects of the level partition (the level might already be destroyed)
+void FTagIndex::RemoveLevelPartition(const TWeakObjectPtr<ULevel>& LevelPtr)
+{
+	// Detach the partition first, the removals would otherwise update it
+	TSet<TWeakObjectPtr<UObject>> Objects;
+	if (LevelObjects.RemoveAndCopyValue(LevelPtr, Objects))
+	{
+		for (const auto& ObjPtr : Objects)
+		{
+			RemoveSingleObject(ObjPtr);
+		}
+	}
+}
+
+// Number of indexed objects of the level
+int32 FTagIndex::NumLevelObjects(ULevel* Level) const
+{
+	const TSet<TWeakObjectPtr<UObject>>* Objects = LevelObjects.Find(Level);
+	return Objects ? Objects->Num() : 0;
+}
+
+// Get the indexed tags data of the object, nullptr if the object has no indexed tags
+const TArray<FTagData>* FTagIndex::FindObjectTags(UObject* Object) const
+{
+	return ObjectTags.Find(Object);
+}
+
+// Get the value to objects map of the tag type key, nullptr if the key is not indexed
+const FTagIndex::ValueToObjectsMap* FTagIndex::FindValueMap(const FString& TagType, const FString& TagKey) const
+{
+	if (const TMap<FString, ValueToObjectsMap>* KeyMap = Entries.Find(TagType))
+	{
+		return KeyMap->Find(TagKey);
+	}
+	return nullptr;
+}
+
+// Get the objects with the tag type key value pair, nullptr if none is indexed
+const FTagIndex::ObjectArray* FTagIndex::FindObjects(const FString& TagType, const FString& TagKey, const FString& TagValue) const
+{
+	if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+	{
+		return ValueMap->Find(TagValue);
+	}
+	return nullptr;
+}
+
+// Mark the tag type key as an identity key (its values are expected to be unique), duplicates are tracked from now on
+void FTagIndex::AddIdentityKey(const FString& TagType, const FString& TagKey)
+{
+	if (IsIdentityKey(TagType, TagKey))
+	{
+		return;
+	}
+
+	// Collect the already indexed duplicates
+	TSet<FString>& Duplicates = IdentityKeys.FindOrAdd(TagType).Add(TagKey);
+	if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+	{
+		for (const auto& ValueToObjects : *ValueMap)
+		{
+			if (ValueToObjects.Value.Num() > 1)
+			{
+				Duplicates.Add(ValueToObjects.Key);
+			}
+		}
+	}
+
+	if (Duplicates.Num() > 0)
+	{
+		UE_LOG(LogTags, Warning, TEXT("%s::%d Identity key %s::%s has %d duplicated values.."),
+			*FString(__func__), __LINE__, *TagType, *TagKey, Duplicates.Num());
+	}
+}
+
+// Stop tracking the duplicates of the identity key
+void FTagIndex::RemoveIdentityKey(const FString& TagType, const FString& TagKey)
+{
+	if (TMap<FString, TSet<FString>>* KeyMap = IdentityKeys.Find(TagType))
+	{
+		KeyMap->Remove(TagKey);
+		if (KeyMap->Num() == 0)
+		{
+			IdentityKeys.Remove(TagType);
+		}
+	}
+}
+
+// Check if the tag type key is an identity key
+bool FTagIndex::IsIdentityKey(const FString& TagType, const FString& TagKey) const
+{
+	const TMap<FString, TSet<FString>>* KeyMap = IdentityKeys.Find(TagType);
+	return KeyMap && KeyMap->Contains(TagKey);
+}
+
+// Get the object with the identity key value, nullptr if none or if the value is shared by more than one object
+UObject* FTagIndex::FindObjectById(const FString& TagType, const FString& TagKey, const FString& TagValue) const
+{
+	UObject* Found = nullptr;
+	if (const ObjectArray* Objects = FindObjects(TagType, TagKey, TagValue))
+	{
+		for (const auto& ObjPtr : *Objects)
+		{
+			if (UObject* Obj = ObjPtr.Get())
+			{
+				if (Found)
+				{
+					return nullptr;
+				}
+				Found = Obj;
+			}
+		}
+	}
+	return Found;
+}
+
+// Get the identity key values shared by more than one valid object
+TArray<FTagIndex::FDuplicateValue> FTagIndex::GetDuplicates() const
+{
+	TArray<FDuplicateValue> Duplicates;
+	for (const auto& TypeToKeys : IdentityKeys)
+	{
+		for (const auto& KeyToDuplicates : TypeToKeys.Value)
+		{
+			for (const auto& Value : KeyToDuplicates.Value)
+			{
+				const ObjectArray* Objects = FindObjects(TypeToKeys.Key, KeyToDuplicates.Key, Value);
+				if (Objects && NumValid(*Objects) > 1)
+				{
+					FDuplicateValue& Duplicate = Duplicates.AddDefaulted_GetRef();
+					Duplicate.TagType = TypeToKeys.Key;
+					Duplicate.TagKey = KeyToDuplicates.Key;
+					Duplicate.Value = Value;
+					Duplicate.Objects = Objects->FilterByPredicate([](const TWeakObjectPtr<UObject>& ObjPtr) { return ObjPtr.IsValid(); });
+				}
+			}
+		}
+	}
+	return Duplicates;
+}
+
+// Check if any identity key value is shared by more than one valid object
+bool FTagIndex::HasDuplicates() const
+{
+	for (const auto& TypeToKeys : IdentityKeys)
+	{
+		for (const auto& KeyToDuplicates : TypeToKeys.Value)
+		{
+			for (const auto& Value : KeyToDuplicates.Value)
+			{
+				const ObjectArray* Objects = FindObjects(TypeToKeys.Key, KeyToDuplicates.Key, Value);
+				if (Objects && NumValid(*Objects) > 1)
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+// Get the objects with the numeric value of the tag type key in [Min, Max], in ascending value order
+TArray<UObject*> FTagIndex::FindObjectsInRange(const FString& TagType, const FString& TagKey, float Min, float Max) const
+{
+	TArray<UObject*> Objects;
+	const NumericArray& Values = GetNumericIndex(TagType, TagKey);
+	for (int32 Idx = LowerBoundValue(Values, Min); Idx < Values.Num() && Values[Idx].Value <= Max; ++Idx)
+	{
+		if (UObject* Obj = Values[Idx].Object.Get())
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			Objects.Emplace(Obj);
+		}
+	}
+	return Objects;
+}
+
+// Get the (up to) K objects with the largest values of the tag type key, largest first (or the smallest, smallest first)
+TArray<UObject*> FTagIndex::FindTopObjects(const FString& TagType, const FString& TagKey, int32 K, bool bLargest) const
+{
+	TArray<UObject*> Objects;
+	const NumericArray& Values = GetNumericIndex(TagType, TagKey);
+	for (int32 Step = 0; Step < Values.Num() && Objects.Num() < K; ++Step)
+	{
+		const FNumericEntry& Entry = Values[bLargest ? Values.Num() - 1 - Step : Step];
+		if (UObject* Obj = Entry.Object.Get())
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			Objects.Emplace(Obj);
+		}
+	}
+	return Objects;
+}
+
+// Get the (up to) K objects with the values of the tag type key closest to the value, closest first
+TArray<UObject*> FTagIndex::FindNearestObjects(const FString& TagType, const FString& TagKey, float Value, int32 K) const
+{
+	TArray<UObject*> Objects;
+	const NumericArray& Values = GetNumericIndex(TagType, TagKey);
+
+	// Walk outwards from the insertion point, taking the closer neighbour first
+	int32 Hi = LowerBoundValue(Values, Value);
+	int32 Lo = Hi - 1;
+	while (Objects.Num() < K && (Lo >= 0 || Hi < Values.Num()))
+	{
+		const bool bTakeLo = Hi >= Values.Num() || (Lo >= 0 && Value - Values[Lo].Value <= Values[Hi].Value - Value);
+		const FNumericEntry& Entry = bTakeLo ? Values[Lo--] : Values[Hi++];
+		if (UObject* Obj = Entry.Object.Get())
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			Objects.Emplace(Obj);
+		}
+	}
+	return Objects;
+}
+
+// Drop the sorted value index of the tag type key (it is built again on the next range query)
+void FTagIndex::RemoveNumericIndex(const FString& TagType, const FString& TagKey)
+{
+	if (TMap<FString, NumericArray>* KeyMap = NumericIndices.Find(TagType))
+	{
+		KeyMap->Remove(TagKey);
+		if (KeyMap->Num() == 0)
+		{
+			NumericIndices.Remove(TagType);
+		}
+	}
+}
+
+// Get the objects with the value of the tag type key starting with the prefix (ignoring case), grouped by value in ascending order
+TArray<UObject*> FTagIndex::FindObjectsWithValuePrefix(const FString& TagType, const FString& TagKey, const FString& Prefix) const
+{
+	TArray<UObject*> Objects;
+	if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+	{
+		// The matching values are contiguous in the sorted values
+		ForEachWithPrefix(GetSortedValues(TagType, TagKey, false).Values, Prefix, [&](const FString& Value)
+		{
+			AppendValueObjects(*ValueMap, Value, Objects);
+		});
+	}
+	return Objects;
+}
+
+// Get the objects with the value of the tag type key ending with the suffix (ignoring case)
+TArray<UObject*> FTagIndex::FindObjectsWithValueSuffix(const FString& TagType, const FString& TagKey, const FString& Suffix) const
+{
+	TArray<UObject*> Objects;
+	if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+	{
+		// A suffix is a prefix of the reversed values
+		ForEachWithPrefix(GetSortedValues(TagType, TagKey, true).ReversedValues, Suffix.Reverse(), [&](const FString& ReversedValue)
+		{
+			AppendValueObjects(*ValueMap, ReversedValue.Reverse(), Objects);
+		});
+	}
+	return Objects;
+}
+
+// Get the objects with the value of the tag type key matching the wildcard pattern ('*' and '?', ignoring case)
+TArray<UObject*> FTagIndex::FindObjectsWithValueMatching(const FString& TagType, const FString& TagKey, const FString& Pattern) const
+{
+	TArray<UObject*> Objects;
+	if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+	{
+		// Only the values sharing the literal start of the pattern are matched
+		int32 WildcardIdx = 0;
+		while (WildcardIdx < Pattern.Len() && Pattern[WildcardIdx] != TEXT('*') && Pattern[WildcardIdx] != TEXT('?'))
+		{
+			++WildcardIdx;
+		}
+		ForEachWithPrefix(GetSortedValues(TagType, TagKey, false).Values, Pattern.Left(WildcardIdx), [&](const FString& Value)
+		{
+			if (FTagView(Value).MatchesWildcard(Pattern))
+			{
+				AppendValueObjects(*ValueMap, Value, Objects);
+			}
+		});
+	}
+	return Objects;
+}
+
+// Drop the sorted distinct values of the tag type key (they are sorted again on the next prefix, suffix or wildcard query)
+void FTagIndex::RemoveValueIndex(const FString& TagType, const FString& TagKey)
+{
+	if (TMap<FString, FSortedValues>* KeyMap = SortedValueIndices.Find(TagType))
+	{
+		KeyMap->Remove(TagKey);
+		if (KeyMap->Num() == 0)
+		{
+			SortedValueIndices.Remove(TagType);
+		}
+	}
+}
+
+// Index the tags of a single object
+void FTagIndex::AddSingleObject(UObject* Object, const TArray<FName>& InTags)
+{
+	const TWeakObjectPtr<UObject> ObjPtr(Object);
+
+	// Clear any previous entries of the object
+	RemoveSingleObject(ObjPtr);
+
+	TArray<FTagData> TagsData;
+	TArray<FTagData> FirstTagsData;
+	ParseTagsData(InTags, TagsData, FirstTagsData);
+	if (const FTagStore* Store = FTagStore::Get())
+	{
+		// Index the values not yet written to the tags
+		Store->ApplyPending(Object, TagsData);
+		Store->ApplyPending(Object, FirstTagsData);
+	}
+	if (TagsData.Num() == 0)
+	{
+		return;
+	}
+
+	for (const auto& TagData : TagsData)
+	{
+		TypeToObjects.FindOrAdd(TagData.TagType).Emplace(ObjPtr);
+	}
+
+	// The key value entries follow the first tag of each type
+	for (const auto& TagData : FirstTagsData.Num() > 0 ? FirstTagsData : TagsData)
+	{
+		TMap<FString, ValueToObjectsMap>& KeyMap = Entries.FindOrAdd(TagData.TagType);
+		for (const auto& KV : TagData.KeyValueMap)
+		{
+			ObjectArray& Objects = KeyMap.FindOrAdd(KV.Key).FindOrAdd(KV.Value);
+			Objects.Emplace(ObjPtr);
+			AddNumericValue(TagData.TagType, KV.Key, KV.Value, ObjPtr);
+			if (Objects.Num() == 1)
+			{
+				AddSortedValue(TagData.TagType, KV.Key, KV.Value);
+			}
+
+			// Report the identity values the moment they stop being unique
+			if (Objects.Num() > 1)
+			{
+				TSet<FString>* Duplicates = FindIdentityDuplicates(TagData.TagType, KV.Key);
+				if (Duplicates && !Duplicates->Contains(KV.Value))
+				{
+					Duplicates->Add(KV.Value);
+					UE_LOG(LogTags, Warning, TEXT("%s::%d Identity key %s::%s value %s is used by %d objects, last added %s.."),
+						*FString(__func__), __LINE__, *TagData.TagType, *KV.Key, *KV.Value, Objects.Num(), *Object->GetName());
+				}
+			}
+		}
+	}
+	ObjectTags.Emplace(ObjPtr, MoveTemp(TagsData));
+	if (FirstTagsData.Num() > 0)
+	{
+		FirstTagsOfType.Emplace(ObjPtr, MoveTemp(FirstTagsData));
+	}
+
+	// Drop the object with its actor when it is destroyed
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		UTagActorWatcher::Watch(Actor);
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		UTagActorWatcher::Watch(Component->GetOwner());
+	}
+
+	// Add to the partition of its level
+	const TWeakObjectPtr<ULevel> LevelPtr(GetObjectLevel(Object));
+	LevelObjects.FindOrAdd(LevelPtr).Add(ObjPtr);
+	ObjectLevels.Emplace(ObjPtr, LevelPtr);
+}
+
+// Remove a single object from the index
+void FTagIndex::RemoveSingleObject(const TWeakObjectPtr<UObject>& ObjPtr)
+{
+	TArray<FTagData> TagsData;
+	if (!ObjectTags.RemoveAndCopyValue(ObjPtr, TagsData))
+	{
+		return;
+	}
+	TArray<FTagData> FirstTagsData;
+	FirstTagsOfType.RemoveAndCopyValue(ObjPtr, FirstTagsData);
+
+	// Remove from the partition of its level (if it was not already dropped)
+	TWeakObjectPtr<ULevel> LevelPtr;
+	if (ObjectLevels.RemoveAndCopyValue(ObjPtr, LevelPtr))
+	{
+		if (TSet<TWeakObjectPtr<UObject>>* LevelObjs = LevelObjects.Find(LevelPtr))
+		{
+			LevelObjs->Remove(ObjPtr);
+			if (LevelObjs->Num() == 0)
+			{
+				LevelObjects.Remove(LevelPtr);
+			}
+		}
+	}
+
+	for (const auto& TagData : TagsData)
+	{
+		if (ObjectArray* Objects = TypeToObjects.Find(TagData.TagType))
+		{
+			Objects->RemoveSingleSwap(ObjPtr);
+			if (Objects->Num() == 0)
+			{
+				TypeToObjects.Remove(TagData.TagType);
+			}
+		}
+	}
+
+	for (const auto& TagData : FirstTagsData.Num() > 0 ? FirstTagsData : TagsData)
+	{
+		if (TMap<FString, ValueToObjectsMap>* KeyMap = Entries.Find(TagData.TagType))
+		{
+			for (const auto& KV : TagData.KeyValueMap)
+			{
+				RemoveNumericValue(TagData.TagType, KV.Key, KV.Value, ObjPtr);
+				if (ValueToObjectsMap* ValueMap = KeyMap->Find(KV.Key))
+				{
+					if (ObjectArray* Objects = ValueMap->Find(KV.Value))
+					{
+						Objects->RemoveSingleSwap(ObjPtr);
+						if (Objects->Num() < 2)
+						{
+							if (TSet<FString>* Duplicates = FindIdentityDuplicates(TagData.TagType, KV.Key))
+							{
+								Duplicates->Remove(KV.Value);
+							}
+						}
+						if (Objects->Num() == 0)
+						{
+							RemoveSortedValue(TagData.TagType, KV.Key, KV.Value);
+							ValueMap->Remove(KV.Value);
+						}
+					}
+					if (ValueMap->Num() == 0)
+					{
+						KeyMap->Remove(KV.Key);
+					}
+				}
+			}
+			if (KeyMap->Num() == 0)
+			{
+				Entries.Remove(TagData.TagType);
+			}
+		}
+	}
+}
+
+// Get the level of the actor or of the component owner
+ULevel* FTagIndex::GetObjectLevel(UObject* Object)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		return Actor->GetLevel();
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		if (AActor* Owner = Component->GetOwner())
+		{
+			return Owner->GetLevel();
+		}
+	}
+	return nullptr;
+}
+
+// Get the tracked duplicate values of the identity key, nullptr if it is not an identity key
+TSet<FString>* FTagIndex::FindIdentityDuplicates(const FString& TagType, const FString& TagKey)
+{
+	if (TMap<FString, TSet<FString>>* KeyMap = IdentityKeys.Find(TagType))
+	{
+		return KeyMap->Find(TagKey);
+	}
+	return nullptr;
+}
+
+// Number of valid objects in the array
+int32 FTagIndex::NumValid(const ObjectArray& Objects)
+{
+	int32 Num = 0;
+	for (const auto& ObjPtr : Objects)
+	{
+		if (ObjPtr.IsValid())
+		{
+			++Num;
+		}
+	}
+	return Num;
+}
+
+// Get the sorted values of the tag type key, built from the indexed values on first use
+const FTagIndex::NumericArray& FTagIndex::GetNumericIndex(const FString& TagType, const FString& TagKey) const
+{
+	TMap<FString, NumericArray>& KeyMap = NumericIndices.FindOrAdd(TagType);
+	if (const NumericArray* Values = KeyMap.Find(TagKey))
+	{
+		return *Values;
+	}
+
+	// Non numeric values are not indexed
+	NumericArray& Values = KeyMap.Add(TagKey);
+	if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+	{
+		for (const auto& ValueToObjects : *ValueMap)
+		{
+			float Value;
+			if (FTagValue::Parse(FTagView(ValueToObjects.Key), Value))
+			{
+				for (const auto& ObjPtr : ValueToObjects.Value)
+				{
+					Values.Add(FNumericEntry{ Value, ObjPtr });
+				}
+			}
+		}
+	}
+	Values.Sort([](const FNumericEntry& A, const FNumericEntry& B) { return A.Value < B.Value; });
+	return Values;
+}
+
+// Insert the value of the object into the sorted values of the key (if built and the value is numeric)
+void FTagIndex::AddNumericValue(const FString& TagType, const FString& TagKey, const FString& TagValue, const TWeakObjectPtr<UObject>& ObjPtr)
+{
+	if (TMap<FString, NumericArray>* KeyMap = NumericIndices.Find(TagType))
+	{
+		if (NumericArray* Values = KeyMap->Find(TagKey))
+		{
+			float Value;
+			if (FTagValue::Parse(FTagView(TagValue), Value))
+			{
+				Values->Insert(FNumericEntry{ Value, ObjPtr }, LowerBoundValue(*Values, Value));
+			}
+		}
+	}
+}
+
+// Remove the value of the object from the sorted values of the key (if built)
+void FTagIndex::RemoveNumericValue(const FString& TagType, const FString& TagKey, const FString& TagValue, const TWeakObjectPtr<UObject>& ObjPtr)
+{
+	if (TMap<FString, NumericArray>* KeyMap = NumericIndices.Find(TagType))
+	{
+		if (NumericArray* Values = KeyMap->Find(TagKey))
+		{
+			float Value;
+			if (FTagValue::Parse(FTagView(TagValue), Value))
+			{
+				// Search the object among the entries of equal value
+				for (int32 Idx = LowerBoundValue(*Values, Value); Idx < Values->Num() && (*Values)[Idx].Value == Value; ++Idx)
+				{
+					if ((*Values)[Idx].Object == ObjPtr)
+					{
+						Values->RemoveAt(Idx, 1, false);
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+// Index of the first value not less than the given one
+int32 FTagIndex::LowerBoundValue(const NumericArray& Values, float Value)
+{
+	return Algo::LowerBoundBy(Values, Value, [](const FNumericEntry& Entry) { return Entry.Value; });
+}
+
+// Get the sorted distinct values of the tag type key, built from the indexed values on first use
+const FTagIndex::FSortedValues& FTagIndex::GetSortedValues(const FString& TagType, const FString& TagKey, bool bWithReversed) const
+{
+	TMap<FString, FSortedValues>& KeyMap = SortedValueIndices.FindOrAdd(TagType);
+	FSortedValues* Sorted = KeyMap.Find(TagKey);
+	if (Sorted == nullptr)
+	{
+		Sorted = &KeyMap.Add(TagKey);
+		if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+		{
+			ValueMap->GenerateKeyArray(Sorted->Values);
+			Sorted->Values.Sort();
+		}
+	}
+	if (bWithReversed && !Sorted->bHasReversed)
+	{
+		Sorted->ReversedValues.Reserve(Sorted->Values.Num());
+		for (const FString& Value : Sorted->Values)
+		{
+			Sorted->ReversedValues.Add(Value.Reverse());
+		}
+		Sorted->ReversedValues.Sort();
+		Sorted->bHasReversed = true;
+	}
+	return *Sorted;
+}
+
+// Insert a distinct value of the key in its sorted values (if built)
+void FTagIndex::AddSortedValue(const FString& TagType, const FString& TagKey, const FString& TagValue)
+{
+	if (TMap<FString, FSortedValues>* KeyMap = SortedValueIndices.Find(TagType))
+	{
+		if (FSortedValues* Sorted = KeyMap->Find(TagKey))
+		{
+			Sorted->Values.Insert(TagValue, Algo::LowerBound(Sorted->Values, TagValue));
+			if (Sorted->bHasReversed)
+			{
+				const FString ReversedValue = TagValue.Reverse();
+				Sorted->ReversedValues.Insert(ReversedValue, Algo::LowerBound(Sorted->ReversedValues, ReversedValue));
+			}
+		}
+	}
+}
+
+// Remove a distinct value of the key from its sorted values (if built)
+void FTagIndex::RemoveSortedValue(const FString& TagType, const FString& TagKey, const FString& TagValue)
+{
+	if (TMap<FString, FSortedValues>* KeyMap = SortedValueIndices.Find(TagType))
+	{
+		if (FSortedValues* Sorted = KeyMap->Find(TagKey))
+		{
+			const int32 Idx = Algo::BinarySearch(Sorted->Values, TagValue);
+			if (Idx != INDEX_NONE)
+			{
+				Sorted->Values.RemoveAt(Idx, 1, false);
+			}
+			if (Sorted->bHasReversed)
+			{
+				const int32 ReversedIdx = Algo::BinarySearch(Sorted->ReversedValues, TagValue.Reverse());
+				if (ReversedIdx != INDEX_NONE)
+				{
+					Sorted->ReversedValues.RemoveAt(ReversedIdx, 1, false);
+				}
+			}
+		}
+	}
+}
+
+// Append the valid objects of the value of the key
+void FTagIndex::AppendValueObjects(const ValueToObjectsMap& ValueMap, const FString& TagValue, TArray<UObject*>& OutObjects)
+{
+	if (const ObjectArray* Objects = ValueMap.Find(TagValue))
+	{
+		for (const auto& ObjPtr : *Objects)
+		{
+			if (UObject* Obj = ObjPtr.Get())
+			{
+				UTAGS_STAT_OBJECTS_VISITED(1);
+				OutObjects.Emplace(Obj);
+			}
+		}
+	}
+}
+
+// Get the indexed tag data of the given type of the object
+const FTagData* FTagIndex::FindObjectTagData(const TWeakObjectPtr<UObject>& ObjPtr, const FString& TagType) const
+{
+	if (const TArray<FTagData>* TagsData = ObjectTags.Find(ObjPtr))
+	{
+		return TagsData->FindByPredicate([&TagType](const FTagData& Data) { return Data.TagType == TagType; });
+	}
+	return nullptr;
+}
+
+// Index newly spawned (or editor placed) actors of the world
+void FTagIndex::OnActorSpawned(AActor* Actor)
+{
+	if (Actor && Actor->GetWorld() == World.Get())
+	{
+		AddObject(Actor);
+	}
+}
+
+// Remove destroyed actors
+void FTagIndex::OnActorDeleted(AActor* Actor)
+{
+	if (Actor && Actor->GetWorld() == World.Get())
+	{
+		RemoveObject(Actor);
+	}
+}
+
+// Drop the collected objects
+void FTagIndex::OnPostGarbageCollect()
+{
+	Compact();
+}
+
+// Re-index the objects changed by the FTags mutators
+void FTagIndex::OnTagsChanged(UObject* Owner)
+{
+	if (Owner && Owner->GetWorld() == World.Get())
+	{
+		if (AActor* Actor = Cast<AActor>(Owner))
+		{
+			AddSingleObject(Actor, Actor->Tags);
+		}
+		else if (UActorComponent* Component = Cast<UActorComponent>(Owner))
+		{
+			AddSingleObject(Component, Component->ComponentTags);
+		}
+	}
+}
+
+// Index the streamed in level
+void FTagIndex::OnLevelAdded(ULevel* InLevel, UWorld* InWorld)
+{
+	if (InWorld == World.Get())
+	{
+		AddLevel(InLevel);
+	}
+}
+
+// Drop the partition of the streamed out level, a null level means all levels are removed
+void FTagIndex::OnLevelRemoved(ULevel* InLevel, UWorld* InWorld)
+{
+	if (InWorld != World.Get())
+	{
+		return;
+	}
+
+	if (InLevel)
+	{
+		RemoveLevel(InLevel);
+	}
+	else
+	{
+		TArray<TWeakObjectPtr<ULevel>> Levels;
+		LevelObjects.GetKeys(Levels);
+		for (const auto& LevelPtr : Levels)
+		{
+			RemoveLevelPartition(LevelPtr);
+		}
+	}
+}
+
+// Drop the index of the world which is cleaned up
+void FTagIndex::OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	Disable(InWorld);
+}
+
+// Access to the enabled world indices
+TMap<TWeakObjectPtr<UWorld>, TUniquePtr<FTagIndex>>& FTagIndex::GetWorldIndices()
+{
+	static TMap<TWeakObjectPtr<UWorld>, TUniquePtr<FTagIndex>> WorldIndices;
+	return WorldIndices;
+}
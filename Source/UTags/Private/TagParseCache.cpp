@@ -0,0 +1,129 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagParseCache.h"
+#include "TagTokenizer.h"
+#include "TagDelimiterScan.h"
+#include "Misc/ScopeRWLock.h"
+
+// Get the module wide cache
+FTagParseCache& FTagParseCache::Get()
+{
+	static FTagParseCache Cache;
+	return Cache;
+}
+
+// Get the parsed data of the tag (untyped tags have an empty type), parses and caches it on a miss
+FTagParseCache::FTagDataRef FTagParseCache::GetTagData(const FName& InTag)
+{
+	{
+		FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+		if (const FEntry* Cached = Entries.Find(InTag))
+		{
+			Hits.Increment();
+			FSlot& Slot = Slots[Cached->SlotIndex];
+			if (!Slot.bReferenced)
+			{
+				Slot.bReferenced = true;
+			}
+			return Cached->Data;
+		}
+	}
+
+	// Parse outside of the lock
+	Misses.Increment();
+	FTagDataRef Parsed = MakeShared<const FTagData, ESPMode::ThreadSafe>(Parse(InTag));
+
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	if (const FEntry* Cached = Entries.Find(InTag))
+	{
+		// Parsed by another thread in the meantime
+		return Cached->Data;
+	}
+	AddEntry(InTag, Parsed);
+	return Parsed;
+}
+
+// Store the parsed tag, evicts an entry if the cache is full (call with the write lock)
+void FTagParseCache::AddEntry(const FName& InTag, const FTagDataRef& Parsed)
+{
+	if (Slots.Num() < MaxEntries)
+	{
+		Entries.Emplace(InTag, FEntry{ Parsed, Slots.Num() });
+		Slots.AddDefaulted_GetRef().Name = InTag;
+		return;
+	}
+
+	// Advance the hand, clearing the referenced flags, until an entry without hits since the last pass
+	while (Slots[ClockHand].bReferenced)
+	{
+		Slots[ClockHand].bReferenced = false;
+		ClockHand = (ClockHand + 1) % Slots.Num();
+	}
+	FSlot& Slot = Slots[ClockHand];
+	Entries.Remove(Slot.Name);
+	Entries.Emplace(InTag, FEntry{ Parsed, ClockHand });
+	Slot.Name = InTag;
+	ClockHand = (ClockHand + 1) % Slots.Num();
+}
+
+// Parse the tag without using the cache
+FTagData FTagParseCache::Parse(const FName& InTag)
+{
+	FTagData TagData;
+	FTagNameBuffer TagBuffer(InTag);
+	// All pairs are needed, the delimiters are found in a single (vectorized) pass
+	FTagSplitter Splitter(TagBuffer.GetView());
+	if (Splitter.HasType())
+	{
+		TagData.TagType = Splitter.GetType().ToString();
+		FTagView CurrKey, CurrValue;
+		while (Splitter.Next(CurrKey, CurrValue))
+		{
+			if (!CurrKey.IsEmpty() && !CurrValue.IsEmpty())
+			{
+				TagData.KeyValueMap.Emplace(CurrKey.ToString(), CurrValue.ToString());
+			}
+		}
+	}
+	return TagData;
+}
+
+// Remove all cached tags (the counters are kept)
+void FTagParseCache::Empty()
+{
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	Entries.Empty();
+	Slots.Empty();
+	ClockHand = 0;
+}
+
+// Set the maximal number of cached tags, entries above the new maximum are evicted
+void FTagParseCache::SetMaxEntries(int32 InMaxEntries)
+{
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	MaxEntries = FMath::Max(InMaxEntries, 1);
+	if (Slots.Num() > MaxEntries)
+	{
+		for (int32 SlotIndex = MaxEntries; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			Entries.Remove(Slots[SlotIndex].Name);
+		}
+		Slots.SetNum(MaxEntries);
+		ClockHand = 0;
+	}
+}
+
+// Number of cached tags
+int32 FTagParseCache::Num() const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	return Entries.Num();
+}
+
+// Reset the hit and miss counters
+void FTagParseCache::ResetCounters()
+{
+	Hits.Reset();
+	Misses.Reset();
+}
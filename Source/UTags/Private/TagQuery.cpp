@@ -0,0 +1,322 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagQuery.h"
+#include "TagIndex.h"
+#include "TagStore.h"
+#include "TagTokenizer.h"
+#include "TagStats.h"
+#include "EngineUtils.h"
+
+// Empty query, matches every actor and component
+FTagQuery::FTagQuery() : RequiredMask(0)
+{
+}
+
+// Query for the tag type key value pair
+FTagQuery::FTagQuery(const FString& TagType, const FString& TagKey, const FString& TagValue) : RequiredMask(0)
+{
+	WithKeyValuePair(TagType, TagKey, TagValue);
+}
+
+// Require a tag of the type
+FTagQuery& FTagQuery::WithType(const FString& TagType)
+{
+	FindOrAddTypeTerm(TagType);
+	return *this;
+}
+
+// Require the key in the tag type
+FTagQuery& FTagQuery::WithKey(const FString& TagType, const FString& TagKey)
+{
+	FindOrAddTypeTerm(TagType).KeyTerms.Add(FKeyTerm{ TagKey, FString(), false });
+	return *this;
+}
+
+// Require the key value pair in the tag type
+FTagQuery& FTagQuery::WithKeyValuePair(const FString& TagType, const FString& TagKey, const FString& TagValue)
+{
+	FindOrAddTypeTerm(TagType).KeyTerms.Add(FKeyTerm{ TagKey, TagValue, true });
+	return *this;
+}
+
+// Get the tag types required by the query
+TArray<FString> FTagQuery::GetTypes() const
+{
+	TArray<FString> TagTypes;
+	TagTypes.Reserve(TypeTerms.Num());
+	for (const auto& TypeTerm : TypeTerms)
+	{
+		TagTypes.Add(TypeTerm.TagType);
+	}
+	return TagTypes;
+}
+
+// Evaluate the query on the tags
+bool FTagQuery::Matches(const TArray<FName>& InTags) const
+{
+	return MatchesTags(InTags, nullptr);
+}
+
+// Evaluate the query on a copy of the tags and of the pending tag store values of their owner
+bool FTagQuery::Matches(const TArray<FName>& InTags, const TArray<FTagStore::FPendingValue>& PendingValues) const
+{
+	if (PendingValues.Num() == 0)
+	{
+		return MatchesTags(InTags, nullptr);
+	}
+	auto FindCopiedValue = [&PendingValues](const FString& TagType, const FString& TagKey, FString& OutValue)
+	{
+		return FTagStore::FindValue(PendingValues, TagType, TagKey, OutValue);
+	};
+	const FFindStoredValue FindStoredValue(FindCopiedValue);
+	return MatchesTags(InTags, &FindStoredValue);
+}
+
+// Evaluate the query on the actor tags
+bool FTagQuery::Matches(AActor* Actor) const
+{
+	return Actor && MatchesObjectTags(Actor, Actor->Tags);
+}
+
+// Evaluate the query on the component tags
+bool FTagQuery::Matches(UActorComponent* Component) const
+{
+	return Component && MatchesObjectTags(Component, Component->ComponentTags);
+}
+
+// Evaluate the query on the actor or component tags, false for other objects
+bool FTagQuery::Matches(UObject* Object) const
+{
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
+	{
+		return Matches(ObjAsAct);
+	}
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+	{
+		return Matches(ObjAsActComp);
+	}
+	return false;
+}
+
+// Call the callback with every matching actor and/or component of the world
+void FTagQuery::ForEachMatch(UWorld* World, bool bActors, bool bComponents, TFunctionRef<bool(UObject*)> Callback) const
+{
+	// Check the object kind, and the full query unless it was answered by the index lookup
+	auto VisitIndexed = [&](UObject* Obj, bool bRecheck)
+	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
+		const bool bIsActor = Obj->IsA(AActor::StaticClass());
+		if ((bIsActor ? !bActors : !bComponents) || (bRecheck && !Matches(Obj)))
+		{
+			return true;
+		}
+		return Callback(Obj);
+	};
+
+	// Use the world tag index if enabled, it resolves the most selective predicate
+	const FTagIndex* Index = FTagIndex::Get(World);
+	const FTypeTerm* IndexedTerm = nullptr;
+	const FKeyTerm* IndexedKey = nullptr;
+	if (Index)
+	{
+		for (const auto& TypeTerm : TypeTerms)
+		{
+			for (const auto& KeyTerm : TypeTerm.KeyTerms)
+			{
+				if (IndexedKey == nullptr || (KeyTerm.bHasValue && !IndexedKey->bHasValue))
+				{
+					IndexedTerm = &TypeTerm;
+					IndexedKey = &KeyTerm;
+				}
+			}
+		}
+	}
+
+	if (IndexedKey)
+	{
+		const bool bRecheck = TypeTerms.Num() > 1 || IndexedTerm->KeyTerms.Num() > 1;
+		if (IndexedKey->bHasValue)
+		{
+			if (const FTagIndex::ObjectArray* Objects = Index->FindObjects(IndexedTerm->TagType, IndexedKey->Key, IndexedKey->Value))
+			{
+				for (const auto& ObjPtr : *Objects)
+				{
+					UObject* Obj = ObjPtr.Get();
+					if (Obj && !VisitIndexed(Obj, bRecheck))
+					{
+						return;
+					}
+				}
+			}
+		}
+		else if (const FTagIndex::ValueToObjectsMap* ValueMap = Index->FindValueMap(IndexedTerm->TagType, IndexedKey->Key))
+		{
+			for (const auto& ValueToObjects : *ValueMap)
+			{
+				for (const auto& ObjPtr : ValueToObjects.Value)
+				{
+					UObject* Obj = ObjPtr.Get();
+					if (Obj && !VisitIndexed(Obj, bRecheck))
+					{
+						return;
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	// Iterate all actors
+	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
+		if (bActors && Matches(*ActorItr) && !Callback(*ActorItr))
+		{
+			return;
+		}
+
+		if (bComponents)
+		{
+			// Iterate components of the actor
+			for (const auto& CompItr : ActorItr->GetComponents())
+			{
+				UTAGS_STAT_OBJECTS_VISITED(1);
+				if (Matches(CompItr) && !Callback(CompItr))
+				{
+					return;
+				}
+			}
+		}
+	}
+}
+
+// Get the term of the type, adds it if needed
+FTagQuery::FTypeTerm& FTagQuery::FindOrAddTypeTerm(const FString& TagType)
+{
+	if (FTypeTerm* Existing = TypeTerms.FindByPredicate([&TagType](const FTypeTerm& Term) { return Term.TagType == TagType; }))
+	{
+		return *Existing;
+	}
+
+	// Look up the type id without registering it (queried types do not use up ids),
+	// types unknown at this point are resolved when matching
+	FTypeTerm& NewTerm = TypeTerms.AddDefaulted_GetRef();
+	NewTerm.TagType = TagType;
+	NewTerm.TypeId = FTagTypeRegistry::Get().FindTypeId(TagType);
+	if (NewTerm.TypeId != INDEX_NONE)
+	{
+		RequiredMask |= FTagTypeRegistry::FTypeMask(1) << NewTerm.TypeId;
+	}
+	return NewTerm;
+}
+
+// Index of the first tag of the term type, INDEX_NONE if not found
+int32 FTagQuery::FindTagIndex(const TArray<FName>& InTags, const FTypeTerm& TypeTerm)
+{
+	FTagTypeRegistry& Registry = FTagTypeRegistry::Get();
+	if (TypeTerm.TypeId == INDEX_NONE)
+	{
+		return Registry.GetTagTypeIndex(InTags, TypeTerm.TagType);
+	}
+
+	// Compare the cached type ids of the tags
+	for (int32 TagIndex = 0; TagIndex < InTags.Num(); ++TagIndex)
+	{
+		if (Registry.GetTagTypeId(InTags[TagIndex]) == TypeTerm.TypeId)
+		{
+			return TagIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+// Evaluate the key predicates on a tag, the pending values (if any) override the tag
+bool FTagQuery::MatchesKeyTerms(const FName& InTag, const FTypeTerm& TypeTerm, const FFindStoredValue* FindStoredValue)
+{
+	if (TypeTerm.KeyTerms.Num() == 0)
+	{
+		return true;
+	}
+
+	FString StoredValue;
+	FTagNameBuffer TagBuffer(InTag);
+	const FTagTokenizer Tokenizer(TagBuffer.GetView());
+	for (const auto& KeyTerm : TypeTerm.KeyTerms)
+	{
+		const FTagStore::EState State = FindStoredValue
+			? (*FindStoredValue)(TypeTerm.TagType, KeyTerm.Key, StoredValue)
+			: FTagStore::EState::None;
+
+		bool bMatch;
+		if (State != FTagStore::EState::None)
+		{
+			bMatch = State == FTagStore::EState::Set && (!KeyTerm.bHasValue || StoredValue == KeyTerm.Value);
+		}
+		else
+		{
+			bMatch = KeyTerm.bHasValue
+				? Tokenizer.HasKeyValuePair(KeyTerm.Key, KeyTerm.Value)
+				: Tokenizer.HasKey(KeyTerm.Key);
+		}
+
+		if (!bMatch)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Evaluate the query on the tags, reading through the pending values (if any)
+bool FTagQuery::MatchesTags(const TArray<FName>& InTags, const FFindStoredValue* FindStoredValue) const
+{
+	for (const auto& TypeTerm : TypeTerms)
+	{
+		const int32 TagIndex = FindTagIndex(InTags, TypeTerm);
+		if (TagIndex == INDEX_NONE || !MatchesKeyTerms(InTags[TagIndex], TypeTerm, FindStoredValue))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Evaluate the query on the tags of an object, after the type mask test
+bool FTagQuery::MatchesObjectTags(UObject* Object, const TArray<FName>& InTags) const
+{
+	if (IsEmpty())
+	{
+		return true;
+	}
+
+	// Reject the objects missing any of the required types without touching the strings
+	FTagTypeRegistry& Registry = FTagTypeRegistry::Get();
+	const FTagTypeRegistry::FTypeMask ObjectMask = Registry.GetObjectTypeMask(Object);
+	if ((ObjectMask & RequiredMask) != RequiredMask)
+	{
+		return false;
+	}
+
+	// The mask registered the object types, a type still unknown can only be carried as a type without an id
+	for (const auto& TypeTerm : TypeTerms)
+	{
+		if (TypeTerm.TypeId == INDEX_NONE && (ObjectMask & FTagTypeRegistry::OverflowBit) == 0 && Registry.FindTypeId(TypeTerm.TagType) == INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	// Values set at runtime are kept in the tag store (if enabled) until flushed
+	const FTagStore* Store = FTagStore::Get();
+	if (Store == nullptr || !Store->HasPending(Object))
+	{
+		return MatchesTags(InTags, nullptr);
+	}
+	auto FindPendingValue = [Store, Object](const FString& TagType, const FString& TagKey, FString& OutValue)
+	{
+		return Store->FindValue(Object, TagType, TagKey, OutValue);
+	};
+	const FFindStoredValue FindStoredValue(FindPendingValue);
+	return MatchesTags(InTags, &FindStoredValue);
+}
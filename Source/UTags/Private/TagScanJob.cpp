@@ -0,0 +1,222 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagScanJob.h"
+#include "TagIndex.h"
+#include "TagStore.h"
+#include "TagStats.h"
+#include "UTags.h"
+#include "Containers/Ticker.h"
+#include "EngineUtils.h"
+
+namespace
+{
+	// Number of actors scanned between two budget checks
+	constexpr int32 ActorsPerBudgetCheck = 16;
+}
+
+// Incremental FTags::GetWorldTagsData
+TSharedRef<FTagScanJob> FTagScanJob::ScanWorldTagsData(UWorld* World,
+	TFunction<void(const TMap<TWeakObjectPtr<UObject>, TArray<FTagData>>&)> OnComplete,
+	double BudgetMs)
+{
+	TSharedRef<FTagScanJob> Job = MakeShareable(new FTagScanJob(World, BudgetMs));
+	TSharedRef<TMap<TWeakObjectPtr<UObject>, TArray<FTagData>>> Result = MakeShared<TMap<TWeakObjectPtr<UObject>, TArray<FTagData>>>();
+
+	Job->VisitObject = [Result](UObject* Object, const TArray<FName>& InTags)
+	{
+		if (InTags.Num() > 0)
+		{
+			Result->Add(Object, FTags::GetObjectTagsData(InTags, Object));
+		}
+	};
+	Job->OnFinished = [Result, OnComplete]()
+	{
+		// Drop the objects destroyed after they were scanned
+		for (auto It = Result->CreateIterator(); It; ++It)
+		{
+			if (!It->Key.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		OnComplete(*Result);
+	};
+	Job->Start();
+	return Job;
+}
+
+// Incremental FTags::GetObjectKeyValuePairsMap (completes on the first tick if the world tag index is enabled)
+TSharedRef<FTagScanJob> FTagScanJob::ScanObjectKeyValuePairsMap(UWorld* World, const FString& TagType,
+	TFunction<void(const TMap<UObject*, TMap<FString, FString>>&)> OnComplete,
+	double BudgetMs)
+{
+	TSharedRef<FTagScanJob> Job = MakeShareable(new FTagScanJob(World, BudgetMs));
+	TSharedRef<TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>> Result = MakeShared<TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>>();
+
+	Job->TryCompleteAtOnce = [TagType, OnComplete](UWorld* InWorld)
+	{
+		// The index answers without iterating the world
+		if (FTagIndex::Get(InWorld))
+		{
+			OnComplete(FTags::GetObjectKeyValuePairsMap(InWorld, TagType));
+			return true;
+		}
+		return false;
+	};
+	Job->VisitObject = [Result, TagType](UObject* Object, const TArray<FName>& InTags)
+	{
+		TMap<FString, FString> KeyValuePairs = FTags::GetKeyValuePairs(InTags, TagType);
+		if (const FTagStore* Store = FTagStore::Get())
+		{
+			Store->ApplyPending(Object, TagType, KeyValuePairs);
+		}
+		if (KeyValuePairs.Num() > 0)
+		{
+			Result->Emplace(Object, MoveTemp(KeyValuePairs));
+		}
+	};
+	Job->OnFinished = [Result, OnComplete]()
+	{
+		// Only the objects still alive are returned
+		TMap<UObject*, TMap<FString, FString>> ObjectToKeyValuePairs;
+		ObjectToKeyValuePairs.Reserve(Result->Num());
+		for (auto& ObjectToPairs : *Result)
+		{
+			if (UObject* Object = ObjectToPairs.Key.Get())
+			{
+				ObjectToKeyValuePairs.Emplace(Object, MoveTemp(ObjectToPairs.Value));
+			}
+		}
+		OnComplete(ObjectToKeyValuePairs);
+	};
+	Job->Start();
+	return Job;
+}
+
+// Stop the scan on the next tick, the completion callback is not called
+void FTagScanJob::Cancel()
+{
+	if (State == EState::Running)
+	{
+		State = EState::Cancelled;
+	}
+}
+
+// Scanned fraction of the actors [0, 1]
+float FTagScanJob::GetProgress() const
+{
+	if (State == EState::Complete)
+	{
+		return 1.f;
+	}
+	return Actors.Num() > 0 ? static_cast<float>(NextActor) / Actors.Num() : 0.f;
+}
+
+// Use the Scan* functions
+FTagScanJob::FTagScanJob(UWorld* InWorld, double BudgetMs)
+	: World(InWorld)
+	, BudgetSeconds(FMath::Max(BudgetMs, 0.0) / 1000.0)
+	, NextActor(0)
+	, bGathered(false)
+	, Frames(0)
+	, State(EState::Running)
+{
+}
+
+// Register the job to the ticker, the ticker holds the job until it finishes
+void FTagScanJob::Start()
+{
+	TSharedRef<FTagScanJob> Self = AsShared();
+	FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Self](float DeltaTime)
+	{
+		// Returning false removes the ticker and releases the job
+		return Self->Tick(DeltaTime);
+	}));
+}
+
+// Scan until the budget is used up, false when done
+bool FTagScanJob::Tick(float DeltaTime)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(ScanJobTick);
+	if (State != EState::Running)
+	{
+		return false;
+	}
+
+	UWorld* ScanWorld = World.Get();
+	if (ScanWorld == nullptr)
+	{
+		UE_LOG(LogTags, Warning, TEXT("%s::%d The world was destroyed before the tag scan completed.."), *FString(__func__), __LINE__);
+		Finish(EState::Cancelled);
+		return false;
+	}
+
+	++Frames;
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+	if (!bGathered)
+	{
+		if (TryCompleteAtOnce && TryCompleteAtOnce(ScanWorld))
+		{
+			State = EState::Complete;
+			return false;
+		}
+
+		// Only the weak pointers are collected, the parsing is spread over the frames
+		for (TActorIterator<AActor> ActorItr(ScanWorld); ActorItr; ++ActorItr)
+		{
+			Actors.Emplace(*ActorItr);
+		}
+		bGathered = true;
+	}
+
+	while (NextActor < Actors.Num())
+	{
+		const int32 ChunkEnd = FMath::Min(NextActor + ActorsPerBudgetCheck, Actors.Num());
+		for (; NextActor < ChunkEnd; ++NextActor)
+		{
+			// Actors destroyed since the collection are skipped
+			if (AActor* Actor = Actors[NextActor].Get())
+			{
+				ScanActor(Actor);
+			}
+		}
+		if (FPlatformTime::Seconds() >= EndTime && NextActor < Actors.Num())
+		{
+			return true;
+		}
+	}
+
+	Finish(EState::Complete);
+	return false;
+}
+
+// Parse the actor and its components
+void FTagScanJob::ScanActor(AActor* Actor)
+{
+	UTAGS_STAT_OBJECTS_VISITED(1);
+	VisitObject(Actor, Actor->Tags);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component)
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			VisitObject(Component, Component->ComponentTags);
+		}
+	}
+}
+
+// Finish the scan with the given state
+void FTagScanJob::Finish(EState InState)
+{
+	State = InState;
+	if (InState == EState::Complete && OnFinished)
+	{
+		OnFinished();
+	}
+	// Release the partial results
+	TryCompleteAtOnce = nullptr;
+	VisitObject = nullptr;
+	OnFinished = nullptr;
+}
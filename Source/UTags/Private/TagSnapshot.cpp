@@ -0,0 +1,210 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagSnapshot.h"
+#include "TagIndex.h"
+#include "TagStats.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Latest published snapshot of every world, the lock only guards the pointer swaps and copies
+	struct FPublishedSnapshots
+	{
+		FCriticalSection Lock;
+		TMap<FObjectKey, FTagSnapshotPtr> Snapshots;
+	};
+
+	FPublishedSnapshots& GetPublished()
+	{
+		static FPublishedSnapshots Published;
+		return Published;
+	}
+}
+
+// Build a snapshot of the actors and components of the world (game thread)
+FTagSnapshotPtr FTagSnapshot::Build(UWorld* World)
+{
+	return FTagSnapshotPtr(BuildSnapshot(World, 0));
+}
+
+// Build the next version of the world snapshot and publish it (game thread)
+FTagSnapshotPtr FTagSnapshot::Publish(UWorld* World)
+{
+	check(IsInGameThread());
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Drop the snapshots of the worlds which are cleaned up
+	static bool bWorldCleanupRegistered = false;
+	if (!bWorldCleanupRegistered)
+	{
+		FWorldDelegates::OnWorldCleanup.AddStatic(&FTagSnapshot::OnWorldCleanup);
+		bWorldCleanupRegistered = true;
+	}
+
+	// Only the game thread publishes, the previous version can be read without the lock
+	const FTagSnapshotPtr Previous = GetLatest(World);
+	const FTagSnapshotPtr Next(BuildSnapshot(World, Previous.IsValid() ? Previous->Version + 1 : 1));
+
+	FPublishedSnapshots& Published = GetPublished();
+	{
+		FScopeLock ScopeLock(&Published.Lock);
+		Published.Snapshots.Emplace(FObjectKey(World), Next);
+	}
+	return Next;
+}
+
+// Drop the published snapshot of the world, readers keep their references
+void FTagSnapshot::Unpublish(UWorld* World)
+{
+	// Release the snapshot outside of the lock
+	FTagSnapshotPtr Removed;
+	FPublishedSnapshots& Published = GetPublished();
+	{
+		FScopeLock ScopeLock(&Published.Lock);
+		Published.Snapshots.RemoveAndCopyValue(FObjectKey(World), Removed);
+	}
+}
+
+// Get the latest published snapshot of the world (any thread), nullptr if none is published
+FTagSnapshotPtr FTagSnapshot::GetLatest(const FObjectKey& WorldKey)
+{
+	FPublishedSnapshots& Published = GetPublished();
+	FScopeLock ScopeLock(&Published.Lock);
+	const FTagSnapshotPtr* Snapshot = Published.Snapshots.Find(WorldKey);
+	return Snapshot ? *Snapshot : FTagSnapshotPtr();
+}
+
+// Get the tags data of the object, nullptr if the object has no tags
+const TArray<FTagData>* FTagSnapshot::FindObjectTags(const FObjectKey& ObjectKey) const
+{
+	return ObjectTags.Find(ObjectKey);
+}
+
+// Get the key value pairs of the tag type of the object, nullptr if the object has no such tag
+const TMap<FString, FString>* FTagSnapshot::FindKeyValuePairs(const FObjectKey& ObjectKey, const FString& TagType) const
+{
+	if (const TArray<FTagData>* TagsData = ObjectTags.Find(ObjectKey))
+	{
+		if (const FTagData* TagData = TagsData->FindByPredicate([&TagType](const FTagData& Data) { return Data.TagType == TagType; }))
+		{
+			return &TagData->KeyValueMap;
+		}
+	}
+	return nullptr;
+}
+
+// Get the value of the tag type key of the object, false if not found
+bool FTagSnapshot::GetValue(const FObjectKey& ObjectKey, const FString& TagType, const FString& TagKey, FString& OutValue) const
+{
+	if (const TMap<FString, FString>* KeyValuePairs = FindKeyValuePairs(ObjectKey, TagType))
+	{
+		if (const FString* Value = KeyValuePairs->Find(TagKey))
+		{
+			OutValue = *Value;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Get the objects with the tag type, nullptr if none
+const TArray<FObjectKey>* FTagSnapshot::FindObjectsWithType(const FString& TagType) const
+{
+	return TypeToObjects.Find(TagType);
+}
+
+// Get the objects with the tag type key value pair, nullptr if none
+const TArray<FObjectKey>* FTagSnapshot::FindObjectsWithKeyValuePair(const FString& TagType, const FString& TagKey, const FString& TagValue) const
+{
+	if (const TMap<FString, TMap<FString, TArray<FObjectKey>>>* KeyMap = Entries.Find(TagType))
+	{
+		if (const TMap<FString, TArray<FObjectKey>>* ValueMap = KeyMap->Find(TagKey))
+		{
+			return ValueMap->Find(TagValue);
+		}
+	}
+	return nullptr;
+}
+
+// Add the tags data of the object and its lookup entries
+void FTagSnapshot::AddObject(UObject* Object, const TArray<FTagData>& TagsData)
+{
+	const FObjectKey ObjectKey(Object);
+	TArray<FTagData>& SnapshotTagsData = ObjectTags.Add(ObjectKey);
+	for (const auto& TagData : TagsData)
+	{
+		if (TagData.TagType.IsEmpty())
+		{
+			continue;
+		}
+
+		SnapshotTagsData.Add(TagData);
+		TypeToObjects.FindOrAdd(TagData.TagType).Add(ObjectKey);
+		TMap<FString, TMap<FString, TArray<FObjectKey>>>& KeyMap = Entries.FindOrAdd(TagData.TagType);
+		for (const auto& KV : TagData.KeyValueMap)
+		{
+			KeyMap.FindOrAdd(KV.Key).FindOrAdd(KV.Value).Add(ObjectKey);
+		}
+	}
+
+	if (SnapshotTagsData.Num() == 0)
+	{
+		ObjectTags.Remove(ObjectKey);
+	}
+}
+
+// Build the snapshot with the given version
+FTagSnapshot* FTagSnapshot::BuildSnapshot(UWorld* World, int64 InVersion)
+{
+	check(IsInGameThread());
+	FTagSnapshot* Snapshot = new FTagSnapshot();
+	Snapshot->Version = InVersion;
+	if (World == nullptr)
+	{
+		return Snapshot;
+	}
+
+	// Copy the already parsed data of the world tag index if enabled, otherwise parse the world in parallel
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			if (const TArray<FTagData>* ActorTagsData = Index->FindObjectTags(*ActorItr))
+			{
+				Snapshot->AddObject(*ActorItr, *ActorTagsData);
+			}
+			for (const auto& CompItr : ActorItr->GetComponents())
+			{
+				UTAGS_STAT_OBJECTS_VISITED(1);
+				if (const TArray<FTagData>* CompTagsData = Index->FindObjectTags(CompItr))
+				{
+					Snapshot->AddObject(CompItr, *CompTagsData);
+				}
+			}
+		}
+	}
+	else
+	{
+		for (const auto& ObjectToTagsData : FTags::GetWorldTagsDataParallel(World))
+		{
+			if (UObject* Object = ObjectToTagsData.Key.Get())
+			{
+				Snapshot->AddObject(Object, ObjectToTagsData.Value);
+			}
+		}
+	}
+	return Snapshot;
+}
+
+// Drop the snapshot of the world which is cleaned up
+void FTagSnapshot::OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	Unpublish(InWorld);
+}
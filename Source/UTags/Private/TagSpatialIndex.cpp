@@ -0,0 +1,601 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagSpatialIndex.h"
+#include "TagActorWatcher.h"
+#include "TagParseCache.h"
+#include "TagStats.h"
+#include "Tags.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	// Largest cell coordinate, keeps the cell arithmetic from overflowing on huge locations
+	constexpr float MaxCellCoord = 1 << 28;
+
+	// Chebyshev distance of the cells
+	FORCEINLINE int32 CellDistance(const FIntVector& A, const FIntVector& B)
+	{
+		return FMath::Max3(FMath::Abs(A.X - B.X), FMath::Abs(A.Y - B.Y), FMath::Abs(A.Z - B.Z));
+	}
+}
+
+// Create and build the spatial index of the world (returns the existing one if already enabled)
+FTagSpatialIndex* FTagSpatialIndex::Enable(UWorld* World, float CellSize)
+{
+	if (World == nullptr || CellSize <= 0.f)
+	{
+		return nullptr;
+	}
+
+	if (FTagSpatialIndex* Existing = Get(World))
+	{
+		return Existing;
+	}
+
+	// Drop the indices of the worlds which are cleaned up
+	static bool bWorldCleanupRegistered = false;
+	if (!bWorldCleanupRegistered)
+	{
+		FWorldDelegates::OnWorldCleanup.AddStatic(&FTagSpatialIndex::OnWorldCleanup);
+		bWorldCleanupRegistered = true;
+	}
+
+	FTagSpatialIndex* NewIndex = new FTagSpatialIndex(World, CellSize);
+	GetWorldIndices().Emplace(World, TUniquePtr<FTagSpatialIndex>(NewIndex));
+	NewIndex->Rebuild();
+	return NewIndex;
+}
+
+// Remove the spatial index of the world
+void FTagSpatialIndex::Disable(UWorld* World)
+{
+	GetWorldIndices().Remove(World);
+}
+
+// Get the spatial index of the world, nullptr if it is not enabled
+FTagSpatialIndex* FTagSpatialIndex::Get(UWorld* World)
+{
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+	if (TUniquePtr<FTagSpatialIndex>* Index = GetWorldIndices().Find(World))
+	{
+		return Index->Get();
+	}
+	return nullptr;
+}
+
+// Register to the world and engine events
+FTagSpatialIndex::FTagSpatialIndex(UWorld* InWorld, float InCellSize) : World(InWorld), CellSize(InCellSize)
+{
+	ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateRaw(this, &FTagSpatialIndex::OnActorSpawned));
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FTagSpatialIndex::OnActorSpawned);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FTagSpatialIndex::OnActorDeleted);
+	}
+	TagsChangedHandle = FTags::OnTagsChanged().AddRaw(this, &FTagSpatialIndex::OnTagsChanged);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FTagSpatialIndex::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FTagSpatialIndex::OnLevelRemoved);
+	ActorDestroyedHandle = UTagActorWatcher::OnActorDestroyed().AddRaw(this, &FTagSpatialIndex::OnActorDeleted);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FTagSpatialIndex::OnPostGarbageCollect);
+}
+
+// Unregister from the world, engine and transform events
+FTagSpatialIndex::~FTagSpatialIndex()
+{
+	for (const auto& ActorToEntry : ActorEntries)
+	{
+		if (USceneComponent* Root = ActorToEntry.Value.Root.Get())
+		{
+			Root->TransformUpdated.Remove(ActorToEntry.Value.TransformHandle);
+		}
+	}
+	if (UWorld* IndexedWorld = World.Get())
+	{
+		IndexedWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+	FTags::OnTagsChanged().Remove(TagsChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	UTagActorWatcher::OnActorDestroyed().Remove(ActorDestroyedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+}
+
+// Clear and re-index all the actors of the world
+void FTagSpatialIndex::Rebuild()
+{
+	TArray<TWeakObjectPtr<AActor>> IndexedActors;
+	ActorEntries.GetKeys(IndexedActors);
+	for (const auto& ActorPtr : IndexedActors)
+	{
+		RemoveEntry(ActorPtr);
+	}
+	Grids.Empty();
+
+	if (UWorld* IndexedWorld = World.Get())
+	{
+		for (TActorIterator<AActor> ActorItr(IndexedWorld); ActorItr; ++ActorItr)
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			AddActor(*ActorItr);
+		}
+	}
+}
+
+// (Re)index the actor with the tag types and location it has now
+void FTagSpatialIndex::AddActor(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+	const TWeakObjectPtr<AActor> ActorPtr(Actor);
+	RemoveEntry(ActorPtr);
+
+	// Only located actors with typed tags are indexed
+	USceneComponent* Root = Actor->GetRootComponent();
+	if (Root == nullptr)
+	{
+		return;
+	}
+	TArray<FString> TagTypes;
+	for (const FName& Tag : Actor->Tags)
+	{
+		const FTagParseCache::FTagDataRef TagData = FTagParseCache::Get().GetTagData(Tag);
+		if (!TagData->TagType.IsEmpty())
+		{
+			TagTypes.AddUnique(TagData->TagType);
+		}
+	}
+	if (TagTypes.Num() == 0)
+	{
+		return;
+	}
+
+	FActorEntry& Entry = ActorEntries.Add(ActorPtr);
+	Entry.TagTypes = MoveTemp(TagTypes);
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+	Entry.Root = Root;
+	Entry.TransformHandle = Root->TransformUpdated.AddRaw(this, &FTagSpatialIndex::OnTransformUpdated);
+	UTagActorWatcher::Watch(Actor);
+	for (const FString& TagType : Entry.TagTypes)
+	{
+		AddToGrid(TagType, Entry.Cell, ActorPtr, Entry.Location);
+	}
+}
+
+// Remove the entries of the destroyed (garbage collected) actors, returns the number of removed entries
+int32 FTagSpatialIndex::Compact()
+{
+	TArray<TWeakObjectPtr<AActor>> Destroyed;
+	for (const auto& ActorToEntry : ActorEntries)
+	{
+		if (!ActorToEntry.Key.IsValid())
+		{
+			Destroyed.Add(ActorToEntry.Key);
+		}
+	}
+	for (const auto& ActorPtr : Destroyed)
+	{
+		RemoveEntry(ActorPtr);
+	}
+	return Destroyed.Num();
+}
+
+// Remove the actor from the index
+void FTagSpatialIndex::RemoveActor(AActor* Actor)
+{
+	RemoveEntry(Actor);
+}
+
+// Get the actors matching the query inside the box, false if the query has no tag type (the index cannot answer it)
+bool FTagSpatialIndex::FindActorsInBox(const FTagQuery& Query, const FBox& Box, TArray<AActor*>& OutActors) const
+{
+	const FGrid* Grid = nullptr;
+	if (!FindQueryGrid(Query, Grid))
+	{
+		return false;
+	}
+	if (Grid)
+	{
+		ForEachInCells(*Grid, Query, GetCell(Box.Min), GetCell(Box.Max), [&](AActor* Actor, const FVector& Location)
+		{
+			if (Box.IsInsideOrOn(Location))
+			{
+				OutActors.Emplace(Actor);
+			}
+		});
+	}
+	return true;
+}
+
+// Get the actors matching the query inside the sphere, false if the query has no tag type
+bool FTagSpatialIndex::FindActorsInSphere(const FTagQuery& Query, const FVector& Center, float Radius, TArray<AActor*>& OutActors) const
+{
+	const FGrid* Grid = nullptr;
+	if (!FindQueryGrid(Query, Grid))
+	{
+		return false;
+	}
+	if (Grid)
+	{
+		const float RadiusSquared = FMath::Square(Radius);
+		ForEachInCells(*Grid, Query, GetCell(Center - FVector(Radius)), GetCell(Center + FVector(Radius)), [&](AActor* Actor, const FVector& Location)
+		{
+			if (FVector::DistSquared(Location, Center) <= RadiusSquared)
+			{
+				OutActors.Emplace(Actor);
+			}
+		});
+	}
+	return true;
+}
+
+// Get the (up to) K actors matching the query closest to the location (within the max distance), closest first, false if the query has no tag type
+bool FTagSpatialIndex::FindNearestActors(const FTagQuery& Query, const FVector& Location, int32 K, float MaxDistance, TArray<AActor*>& OutActors) const
+{
+	const FGrid* Grid = nullptr;
+	if (!FindQueryGrid(Query, Grid))
+	{
+		return false;
+	}
+	if (Grid == nullptr || K <= 0)
+	{
+		return true;
+	}
+
+	// Squared distance and actor, the K closest are kept sorted
+	TArray<TPair<float, AActor*>> Candidates;
+	const float MaxDistanceSquared = FMath::Square(MaxDistance);
+	auto AddCandidate = [&](AActor* Actor, const FVector& ActorLocation)
+	{
+		const float DistanceSquared = FVector::DistSquared(ActorLocation, Location);
+		if (DistanceSquared <= MaxDistanceSquared)
+		{
+			Candidates.Emplace(DistanceSquared, Actor);
+		}
+	};
+	auto KeepClosest = [&]()
+	{
+		Candidates.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+		if (Candidates.Num() > K)
+		{
+			Candidates.SetNum(K, false);
+		}
+	};
+
+	// Search rings of cells outwards, up to the bounds of the grid
+	const FIntVector Center = GetCell(Location);
+	const int32 MaxRing = FMath::Max(CellDistance(Center, Grid->MinCell), CellDistance(Center, Grid->MaxCell));
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// The cells of the ring are at least (Ring - 1) cells away from the location
+		const float RingDistance = FMath::Max(Ring - 1, 0) * CellSize;
+		if (RingDistance > MaxDistance || (Candidates.Num() >= K && Candidates.Last().Key <= FMath::Square(RingDistance)))
+		{
+			break;
+		}
+
+		// Visit the remaining cells directly once the ring has more cells than the grid
+		const int64 NumRingCells = Ring == 0 ? 1 : 24 * int64(Ring) * Ring + 2;
+		if (NumRingCells > Grid->Cells.Num())
+		{
+			for (const auto& CellToEntries : Grid->Cells)
+			{
+				if (CellDistance(CellToEntries.Key, Center) >= Ring)
+				{
+					ForEachInCell(CellToEntries.Value, Query, AddCandidate);
+				}
+			}
+			KeepClosest();
+			break;
+		}
+
+		// Only the shell of the ring cube
+		for (int32 DX = -Ring; DX <= Ring; ++DX)
+		{
+			for (int32 DY = -Ring; DY <= Ring; ++DY)
+			{
+				const bool bOnSide = FMath::Abs(DX) == Ring || FMath::Abs(DY) == Ring;
+				for (int32 DZ = -Ring; DZ <= Ring; DZ += (bOnSide || Ring == 0) ? 1 : 2 * Ring)
+				{
+					if (const TArray<FCellEntry>* CellEntries = Grid->Cells.Find(Center + FIntVector(DX, DY, DZ)))
+					{
+						ForEachInCell(*CellEntries, Query, AddCandidate);
+					}
+				}
+			}
+		}
+		KeepClosest();
+	}
+
+	for (const auto& Candidate : Candidates)
+	{
+		OutActors.Emplace(Candidate.Value);
+	}
+	return true;
+}
+
+// Get the cell of the location
+FIntVector FTagSpatialIndex::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(FMath::Clamp(Location.X / CellSize, -MaxCellCoord, MaxCellCoord)),
+		FMath::FloorToInt(FMath::Clamp(Location.Y / CellSize, -MaxCellCoord, MaxCellCoord)),
+		FMath::FloorToInt(FMath::Clamp(Location.Z / CellSize, -MaxCellCoord, MaxCellCoord)));
+}
+
+// Add the actor to the cell of the tag type grid
+void FTagSpatialIndex::AddToGrid(const FString& TagType, const FIntVector& Cell, const TWeakObjectPtr<AActor>& ActorPtr, const FVector& Location)
+{
+	FGrid& Grid = Grids.FindOrAdd(TagType);
+	if (Grid.NumActors == 0)
+	{
+		Grid.MinCell = Cell;
+		Grid.MaxCell = Cell;
+	}
+	else
+	{
+		Grid.MinCell = FIntVector(FMath::Min(Grid.MinCell.X, Cell.X), FMath::Min(Grid.MinCell.Y, Cell.Y), FMath::Min(Grid.MinCell.Z, Cell.Z));
+		Grid.MaxCell = FIntVector(FMath::Max(Grid.MaxCell.X, Cell.X), FMath::Max(Grid.MaxCell.Y, Cell.Y), FMath::Max(Grid.MaxCell.Z, Cell.Z));
+	}
+	Grid.Cells.FindOrAdd(Cell).Add(FCellEntry{ ActorPtr, Location });
+	++Grid.NumActors;
+}
+
+// Remove the actor from the cell of the tag type grid
+void FTagSpatialIndex::RemoveFromGrid(const FString& TagType, const FIntVector& Cell, const TWeakObjectPtr<AActor>& ActorPtr)
+{
+	if (FGrid* Grid = Grids.Find(TagType))
+	{
+		if (TArray<FCellEntry>* CellEntries = Grid->Cells.Find(Cell))
+		{
+			const int32 Idx = CellEntries->IndexOfByPredicate([&ActorPtr](const FCellEntry& CellEntry) { return CellEntry.Actor == ActorPtr; });
+			if (Idx != INDEX_NONE)
+			{
+				CellEntries->RemoveAtSwap(Idx, 1, false);
+				--Grid->NumActors;
+			}
+			if (CellEntries->Num() == 0)
+			{
+				Grid->Cells.Remove(Cell);
+			}
+		}
+		if (Grid->NumActors == 0)
+		{
+			Grids.Remove(TagType);
+		}
+	}
+}
+
+// Remove the actor entry and its transform binding
+void FTagSpatialIndex::RemoveEntry(const TWeakObjectPtr<AActor>& ActorPtr)
+{
+	FActorEntry Entry;
+	if (!ActorEntries.RemoveAndCopyValue(ActorPtr, Entry))
+	{
+		return;
+	}
+	if (USceneComponent* Root = Entry.Root.Get())
+	{
+		Root->TransformUpdated.Remove(Entry.TransformHandle);
+	}
+	for (const FString& TagType : Entry.TagTypes)
+	{
+		RemoveFromGrid(TagType, Entry.Cell, ActorPtr);
+	}
+}
+
+// Get the grid of the least populated tag type of the query, false if the query has no tag type
+bool FTagSpatialIndex::FindQueryGrid(const FTagQuery& Query, const FGrid*& OutGrid) const
+{
+	const TArray<FString> TagTypes = Query.GetTypes();
+	if (TagTypes.Num() == 0)
+	{
+		return false;
+	}
+
+	// A missing grid means no actor has the type, the query has no results
+	OutGrid = nullptr;
+	for (const FString& TagType : TagTypes)
+	{
+		const FGrid* Grid = Grids.Find(TagType);
+		if (Grid == nullptr)
+		{
+			OutGrid = nullptr;
+			return true;
+		}
+		if (OutGrid == nullptr || Grid->NumActors < OutGrid->NumActors)
+		{
+			OutGrid = Grid;
+		}
+	}
+	return true;
+}
+
+// Call the functor with the valid actors matching the query in the cells of the range, with their indexed location
+void FTagSpatialIndex::ForEachInCells(const FGrid& Grid, const FTagQuery& Query, const FIntVector& MinCell, const FIntVector& MaxCell, TFunctionRef<void(AActor*, const FVector&)> Functor) const
+{
+	// Only the part of the range covered by the grid
+	const FIntVector Min(FMath::Max(MinCell.X, Grid.MinCell.X), FMath::Max(MinCell.Y, Grid.MinCell.Y), FMath::Max(MinCell.Z, Grid.MinCell.Z));
+	const FIntVector Max(FMath::Min(MaxCell.X, Grid.MaxCell.X), FMath::Min(MaxCell.Y, Grid.MaxCell.Y), FMath::Min(MaxCell.Z, Grid.MaxCell.Z));
+	if (Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z)
+	{
+		return;
+	}
+
+	// Large ranges visit the occupied cells instead of looking up every cell of the range
+	const int64 NumRangeCells = int64(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) * (Max.Z - Min.Z + 1);
+	if (NumRangeCells > Grid.Cells.Num())
+	{
+		for (const auto& CellToEntries : Grid.Cells)
+		{
+			const FIntVector& Cell = CellToEntries.Key;
+			if (Cell.X >= Min.X && Cell.X <= Max.X && Cell.Y >= Min.Y && Cell.Y <= Max.Y && Cell.Z >= Min.Z && Cell.Z <= Max.Z)
+			{
+				ForEachInCell(CellToEntries.Value, Query, Functor);
+			}
+		}
+		return;
+	}
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				if (const TArray<FCellEntry>* CellEntries = Grid.Cells.Find(FIntVector(X, Y, Z)))
+				{
+					ForEachInCell(*CellEntries, Query, Functor);
+				}
+			}
+		}
+	}
+}
+
+// Call the functor with the valid actors matching the query in the cell
+void FTagSpatialIndex::ForEachInCell(const TArray<FCellEntry>& CellEntries, const FTagQuery& Query, TFunctionRef<void(AActor*, const FVector&)> Functor)
+{
+	for (const FCellEntry& CellEntry : CellEntries)
+	{
+		AActor* Actor = CellEntry.Actor.Get();
+		if (Actor)
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			if (Query.Matches(Actor))
+			{
+				Functor(Actor, CellEntry.Location);
+			}
+		}
+	}
+}
+
+// Move the actor to the cell of its new location
+void FTagSpatialIndex::OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	AActor* Actor = Component ? Component->GetOwner() : nullptr;
+	FActorEntry* Entry = Actor ? ActorEntries.Find(Actor) : nullptr;
+	if (Entry == nullptr)
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<AActor> ActorPtr(Actor);
+	const FVector Location = Actor->GetActorLocation();
+	const FIntVector Cell = GetCell(Location);
+	for (const FString& TagType : Entry->TagTypes)
+	{
+		if (Cell != Entry->Cell)
+		{
+			RemoveFromGrid(TagType, Entry->Cell, ActorPtr);
+			AddToGrid(TagType, Cell, ActorPtr, Location);
+		}
+		else if (FGrid* Grid = Grids.Find(TagType))
+		{
+			// Same cell, only the location changes
+			if (TArray<FCellEntry>* CellEntries = Grid->Cells.Find(Cell))
+			{
+				if (FCellEntry* CellEntry = CellEntries->FindByPredicate([&ActorPtr](const FCellEntry& InEntry) { return InEntry.Actor == ActorPtr; }))
+				{
+					CellEntry->Location = Location;
+				}
+			}
+		}
+	}
+	Entry->Location = Location;
+	Entry->Cell = Cell;
+}
+
+// Index the spawned actors
+void FTagSpatialIndex::OnActorSpawned(AActor* Actor)
+{
+	if (Actor && Actor->GetWorld() == World.Get())
+	{
+		AddActor(Actor);
+	}
+}
+
+// Remove destroyed actors
+void FTagSpatialIndex::OnActorDeleted(AActor* Actor)
+{
+	if (Actor && Actor->GetWorld() == World.Get())
+	{
+		RemoveActor(Actor);
+	}
+}
+
+// Re-partition the actors changed by the FTags mutators (component tags are not indexed)
+void FTagSpatialIndex::OnTagsChanged(UObject* Owner)
+{
+	AActor* Actor = Cast<AActor>(Owner);
+	if (Actor && Actor->GetWorld() == World.Get())
+	{
+		AddActor(Actor);
+	}
+}
+
+// Index the actors of the streamed in level
+void FTagSpatialIndex::OnLevelAdded(ULevel* InLevel, UWorld* InWorld)
+{
+	if (InLevel && InWorld == World.Get())
+	{
+		for (AActor* Actor : InLevel->Actors)
+		{
+			AddActor(Actor);
+		}
+	}
+}
+
+// Remove the actors of the streamed out level, a null level means all levels are removed
+void FTagSpatialIndex::OnLevelRemoved(ULevel* InLevel, UWorld* InWorld)
+{
+	if (InWorld != World.Get())
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AActor>> IndexedActors;
+	ActorEntries.GetKeys(IndexedActors);
+	for (const auto& ActorPtr : IndexedActors)
+	{
+		AActor* Actor = ActorPtr.Get();
+		if (InLevel == nullptr || Actor == nullptr || Actor->GetLevel() == InLevel)
+		{
+			RemoveEntry(ActorPtr);
+		}
+	}
+}
+
+// Drop the entries of the actors collected without a destroy notification
+void FTagSpatialIndex::OnPostGarbageCollect()
+{
+	Compact();
+}
+
+// Drop the spatial index of the world which is cleaned up
+void FTagSpatialIndex::OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	Disable(InWorld);
+}
+
+// Access to the enabled world spatial indices
+TMap<TWeakObjectPtr<UWorld>, TUniquePtr<FTagSpatialIndex>>& FTagSpatialIndex::GetWorldIndices()
+{
+	static TMap<TWeakObjectPtr<UWorld>, TUniquePtr<FTagSpatialIndex>> WorldIndices;
+	return WorldIndices;
+}
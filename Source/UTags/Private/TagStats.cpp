@@ -0,0 +1,225 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagStats.h"
+#include "UTags.h"
+#include "Tags.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_STAT(STAT_UTags_Calls);
+DEFINE_STAT(STAT_UTags_ObjectsVisited);
+DEFINE_STAT(STAT_UTags_TagsParsed);
+DEFINE_STAT(STAT_UTags_ResultBytes);
+
+namespace
+{
+	// Running counts of the current thread, the scopes record their difference
+	struct FThreadCounts
+	{
+		int32 Depth = 0;
+		int64 ObjectsVisited = 0;
+		int64 TagsParsed = 0;
+		int64 ResultBytes = 0;
+	};
+
+	FThreadCounts& GetThreadCounts()
+	{
+		static thread_local FThreadCounts Counts;
+		return Counts;
+	}
+
+	// Registered functions
+	struct FFunctionRegistry
+	{
+		FCriticalSection Lock;
+		TArray<TUniquePtr<FTagStats::FFunctionStats>> Functions;
+	};
+
+	FFunctionRegistry& GetRegistry()
+	{
+		static FFunctionRegistry Registry;
+		return Registry;
+	}
+
+	// Result bytes are only measured on request
+	int32 GTrackResultBytes = 0;
+	FAutoConsoleVariableRef CVarTrackResultBytes(
+		TEXT("UTags.StatsResultBytes"),
+		GTrackResultBytes,
+		TEXT("Measure the allocated size of the containers returned by the FTags functions (walks every result)."));
+
+	FAutoConsoleCommand DumpStatsCommand(
+		TEXT("UTags.DumpStats"),
+		TEXT("Log the call counts, time, visited objects, parsed tags and result bytes of the FTags functions."),
+		FConsoleCommandDelegate::CreateStatic(&FTagStats::Dump));
+
+	FAutoConsoleCommand ResetStatsCommand(
+		TEXT("UTags.ResetStats"),
+		TEXT("Clear the FTags function totals."),
+		FConsoleCommandDelegate::CreateStatic(&FTagStats::Reset));
+}
+
+// Records the function call if it is the outermost FTags call of the thread
+FTagStats::FScope::FScope(FFunctionStats& InStats) : Stats(InStats)
+{
+	FThreadCounts& Counts = GetThreadCounts();
+	bOutermost = Counts.Depth++ == 0;
+	if (bOutermost)
+	{
+		StartObjectsVisited = Counts.ObjectsVisited;
+		StartTagsParsed = Counts.TagsParsed;
+		StartResultBytes = Counts.ResultBytes;
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+// Add the differences to the function totals
+FTagStats::FScope::~FScope()
+{
+	FThreadCounts& Counts = GetThreadCounts();
+	--Counts.Depth;
+	if (!bOutermost)
+	{
+		return;
+	}
+
+	const int64 ObjectsVisited = Counts.ObjectsVisited - StartObjectsVisited;
+	const int64 TagsParsed = Counts.TagsParsed - StartTagsParsed;
+	const int64 ResultBytes = Counts.ResultBytes - StartResultBytes;
+	Stats.Cycles.Add(FPlatformTime::Cycles64() - StartCycles);
+	Stats.Calls.Increment();
+	Stats.ObjectsVisited.Add(ObjectsVisited);
+	Stats.TagsParsed.Add(TagsParsed);
+	Stats.ResultBytes.Add(ResultBytes);
+
+	INC_DWORD_STAT(STAT_UTags_Calls);
+	INC_DWORD_STAT_BY(STAT_UTags_ObjectsVisited, ObjectsVisited);
+	INC_DWORD_STAT_BY(STAT_UTags_TagsParsed, TagsParsed);
+	INC_DWORD_STAT_BY(STAT_UTags_ResultBytes, ResultBytes);
+}
+
+// Remember the starting thread
+FTagStats::FParallelScope::FParallelScope() : ThreadId(FPlatformTLS::GetCurrentThreadId())
+{
+}
+
+// Add the counts of the tasks that ran on other threads
+FTagStats::FParallelScope::~FParallelScope()
+{
+	FThreadCounts& Counts = GetThreadCounts();
+	Counts.ObjectsVisited += ObjectsVisited.GetValue();
+	Counts.TagsParsed += TagsParsed.GetValue();
+}
+
+// Nest the FTags calls of the task
+FTagStats::FTaskScope::FTaskScope(FParallelScope& InParent) : Parent(InParent)
+{
+	FThreadCounts& Counts = GetThreadCounts();
+	++Counts.Depth;
+	StartObjectsVisited = Counts.ObjectsVisited;
+	StartTagsParsed = Counts.TagsParsed;
+}
+
+// Forward the counts of the task to the starting thread
+FTagStats::FTaskScope::~FTaskScope()
+{
+	FThreadCounts& Counts = GetThreadCounts();
+	--Counts.Depth;
+	if (FPlatformTLS::GetCurrentThreadId() != Parent.ThreadId)
+	{
+		Parent.ObjectsVisited.Add(Counts.ObjectsVisited - StartObjectsVisited);
+		Parent.TagsParsed.Add(Counts.TagsParsed - StartTagsParsed);
+	}
+}
+
+// Get the entry of the function, added on the first call
+FTagStats::FFunctionStats& FTagStats::FindOrAdd(const TCHAR* Name)
+{
+	FFunctionRegistry& Registry = GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+	for (const auto& Function : Registry.Functions)
+	{
+		if (FCString::Strcmp(Function->Name, Name) == 0)
+		{
+			return *Function;
+		}
+	}
+	FFunctionStats* NewFunction = new FFunctionStats();
+	NewFunction->Name = Name;
+	Registry.Functions.Emplace(NewFunction);
+	return *NewFunction;
+}
+
+// Count the visited objects of the current call
+void FTagStats::AddObjectsVisited(int32 Num)
+{
+	GetThreadCounts().ObjectsVisited += Num;
+}
+
+// Count the parsed tags of the current call
+void FTagStats::AddTagsParsed(int32 Num)
+{
+	GetThreadCounts().TagsParsed += Num;
+}
+
+// Count the allocated bytes of the current call
+void FTagStats::AddResultBytesNum(SIZE_T Num)
+{
+	GetThreadCounts().ResultBytes += Num;
+}
+
+// Check if the result containers are measured
+bool FTagStats::IsTrackingResultBytes()
+{
+	return GTrackResultBytes != 0;
+}
+
+// Log the per function totals, sorted by time
+void FTagStats::Dump()
+{
+	FFunctionRegistry& Registry = GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+
+	TArray<FFunctionStats*> Sorted;
+	for (const auto& Function : Registry.Functions)
+	{
+		Sorted.Add(Function.Get());
+	}
+	Sorted.Sort([](const FFunctionStats& A, const FFunctionStats& B)
+	{
+		return A.Cycles.GetValue() > B.Cycles.GetValue();
+	});
+
+	UE_LOG(LogTags, Display, TEXT("%-36s %12s %12s %12s %14s %14s %14s"),
+		TEXT("Function"), TEXT("Calls"), TEXT("Total ms"), TEXT("Avg us"), TEXT("Objects"), TEXT("Tags parsed"), TEXT("Result bytes"));
+	for (const FFunctionStats* Function : Sorted)
+	{
+		const int64 Calls = Function->Calls.GetValue();
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Function->Cycles.GetValue());
+		UE_LOG(LogTags, Display, TEXT("%-36s %12lld %12.3f %12.3f %14lld %14lld %14lld"),
+			Function->Name, Calls, TotalMs, Calls > 0 ? TotalMs * 1000.0 / Calls : 0.0,
+			Function->ObjectsVisited.GetValue(), Function->TagsParsed.GetValue(), Function->ResultBytes.GetValue());
+	}
+}
+
+// Clear the per function totals
+void FTagStats::Reset()
+{
+	FFunctionRegistry& Registry = GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+	for (const auto& Function : Registry.Functions)
+	{
+		Function->Calls.Reset();
+		Function->Cycles.Reset();
+		Function->ObjectsVisited.Reset();
+		Function->TagsParsed.Reset();
+		Function->ResultBytes.Reset();
+	}
+}
+
+// Allocated size of the tag data strings and map
+SIZE_T FTagStats::GetDeepAllocatedSize(const FTagData& Data)
+{
+	return GetDeepAllocatedSize(Data.TagType) + GetDeepAllocatedSize(Data.KeyValueMap);
+}
@@ -0,0 +1,345 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagStore.h"
+#include "Tags.h"
+#include "TagEditor.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectGlobals.h"
+#if WITH_EDITOR
+#include "Engine/Selection.h"
+#endif // WITH_EDITOR
+
+// Create the store (returns the existing one if already enabled)
+FTagStore* FTagStore::Enable()
+{
+	TUniquePtr<FTagStore>& Instance = GetInstance();
+	if (!Instance.IsValid())
+	{
+		Instance.Reset(new FTagStore());
+	}
+	return Instance.Get();
+}
+
+// Flush all pending values and remove the store
+void FTagStore::Disable()
+{
+	TUniquePtr<FTagStore>& Instance = GetInstance();
+	if (Instance.IsValid())
+	{
+		// Detach first, the flushed tags are written directly
+		TUniquePtr<FTagStore> Store = MoveTemp(Instance);
+		Store->FlushAll();
+	}
+}
+
+// Get the store, nullptr if it is not enabled
+FTagStore* FTagStore::Get()
+{
+	return GetInstance().Get();
+}
+
+// Register to the save, garbage collection and editor selection events
+FTagStore::FTagStore()
+{
+	ObjectSavedHandle = FCoreUObjectDelegates::OnObjectSaved.AddRaw(this, &FTagStore::OnObjectSaved);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FTagStore::OnPostGarbageCollect);
+#if WITH_EDITOR
+	ObjectSelectedHandle = USelection::SelectObjectEvent.AddRaw(this, &FTagStore::OnObjectSelected);
+#endif // WITH_EDITOR
+}
+
+// Unregister from the engine events
+FTagStore::~FTagStore()
+{
+	FCoreUObjectDelegates::OnObjectSaved.Remove(ObjectSavedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+#if WITH_EDITOR
+	USelection::SelectObjectEvent.Remove(ObjectSelectedHandle);
+#endif // WITH_EDITOR
+}
+
+// Check if the tags array is the tags array of the actor or component owner
+bool FTagStore::IsOwnerTags(UObject* Owner, const TArray<FName>& InTags)
+{
+	if (AActor* Actor = Cast<AActor>(Owner))
+	{
+		return &Actor->Tags == &InTags;
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Owner))
+	{
+		return &Component->ComponentTags == &InTags;
+	}
+	return false;
+}
+
+// Set the value of an existing tag type key, false if bReplaceExisting is false and the key already has a value
+bool FTagStore::SetValue(UObject* Owner, const TArray<FName>& OwnerTags, const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting)
+{
+	if (!bReplaceExisting)
+	{
+		FString ExistingValue;
+		const EState State = FindValue(Owner, TagType, TagKey, ExistingValue);
+		if (State == EState::Set || (State == EState::None && FTags::HasKey(OwnerTags, TagType, TagKey)))
+		{
+			return false;
+		}
+	}
+	SetPending(Owner, TagType, TagKey, TagValue, false);
+	return true;
+}
+
+// Remove the key of the tag type, false if the key has no value
+bool FTagStore::RemoveValue(UObject* Owner, const TArray<FName>& OwnerTags, const FString& TagType, const FString& TagKey)
+{
+	FString ExistingValue;
+	const EState State = FindValue(Owner, TagType, TagKey, ExistingValue);
+	if (State == EState::Removed || (State == EState::None && !FTags::HasKey(OwnerTags, TagType, TagKey)))
+	{
+		return false;
+	}
+	SetPending(Owner, TagType, TagKey, FTagView(), true);
+	return true;
+}
+
+// Get the pending state of the key, the value is set if the state is Set
+FTagStore::EState FTagStore::FindValue(UObject* Owner, const FString& TagType, const FString& TagKey, FString& OutValue) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	const TArray<FPendingValue>* Values = Pending.Find(Owner);
+	return Values ? FindValue(*Values, TagType, TagKey, OutValue) : EState::None;
+}
+
+// Apply the pending values of the object to the key value pairs of the tag type
+void FTagStore::ApplyPending(UObject* Owner, const FString& TagType, TMap<FString, FString>& InOutKeyValuePairs) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	if (const TArray<FPendingValue>* Values = Pending.Find(Owner))
+	{
+		ApplyPending(*Values, TagType, InOutKeyValuePairs);
+	}
+}
+
+// Apply the pending values of the object to its parsed tags data
+void FTagStore::ApplyPending(UObject* Owner, TArray<FTagData>& InOutTagsData) const
+{
+	for (auto& TagData : InOutTagsData)
+	{
+		ApplyPending(Owner, TagData.TagType, TagData.KeyValueMap);
+	}
+}
+
+// Copy the pending values of the object (e.g. to read them off the game thread), false if it has none
+bool FTagStore::CopyPending(UObject* Owner, TArray<FPendingValue>& OutValues) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	if (const TArray<FPendingValue>* Values = Pending.Find(Owner))
+	{
+		OutValues = *Values;
+		return true;
+	}
+	return false;
+}
+
+// Get the state of the key in copied pending values, the value is set if the state is Set
+FTagStore::EState FTagStore::FindValue(const TArray<FPendingValue>& Values, const FString& TagType, const FString& TagKey, FString& OutValue)
+{
+	if (const FPendingValue* PendingValue = FindPending(Values, TagType, TagKey))
+	{
+		if (PendingValue->bRemoved)
+		{
+			return EState::Removed;
+		}
+		OutValue = PendingValue->Value;
+		return EState::Set;
+	}
+	return EState::None;
+}
+
+// Apply copied pending values to the key value pairs of the tag type
+void FTagStore::ApplyPending(const TArray<FPendingValue>& Values, const FString& TagType, TMap<FString, FString>& InOutKeyValuePairs)
+{
+	for (const auto& PendingValue : Values)
+	{
+		if (PendingValue.TagType == TagType)
+		{
+			if (PendingValue.bRemoved)
+			{
+				InOutKeyValuePairs.Remove(PendingValue.Key);
+			}
+			else
+			{
+				InOutKeyValuePairs.Emplace(PendingValue.Key, PendingValue.Value);
+			}
+		}
+	}
+}
+
+// Check if the object has pending values
+bool FTagStore::HasPending(UObject* Owner) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	return Pending.Contains(Owner);
+}
+
+// Write the pending values of the object to its tags, returns the number of written values
+int32 FTagStore::Flush(UObject* Owner)
+{
+	TArray<FPendingValue> Values;
+	{
+		FRWScopeLock WriteLock(Lock, SLT_Write);
+		if (!Pending.RemoveAndCopyValue(Owner, Values))
+		{
+			return 0;
+		}
+	}
+	return WriteValues(Owner, Values);
+}
+
+// Write the pending values of all objects, returns the number of written values
+int32 FTagStore::FlushAll()
+{
+	TMap<TWeakObjectPtr<UObject>, TArray<FPendingValue>> AllValues;
+	{
+		FRWScopeLock WriteLock(Lock, SLT_Write);
+		AllValues = MoveTemp(Pending);
+		Pending.Reset();
+	}
+
+	// Values of destroyed objects are dropped
+	int32 NumWritten = 0;
+	for (const auto& ObjectToValues : AllValues)
+	{
+		if (UObject* Owner = ObjectToValues.Key.Get())
+		{
+			NumWritten += WriteValues(Owner, ObjectToValues.Value);
+		}
+	}
+	return NumWritten;
+}
+
+// Drop the pending values of the object
+void FTagStore::Discard(UObject* Owner)
+{
+	bool bRemoved = false;
+	{
+		FRWScopeLock WriteLock(Lock, SLT_Write);
+		bRemoved = Pending.Remove(Owner) > 0;
+	}
+	if (bRemoved)
+	{
+		FTags::OnTagsChanged().Broadcast(Owner);
+	}
+}
+
+// Number of objects with pending values
+int32 FTagStore::NumPendingObjects() const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	return Pending.Num();
+}
+
+// Find the pending value of the key
+FTagStore::FPendingValue* FTagStore::FindPending(TArray<FPendingValue>& Values, const FString& TagType, const FString& TagKey)
+{
+	return Values.FindByPredicate([&](const FPendingValue& Value) { return Value.Key == TagKey && Value.TagType == TagType; });
+}
+
+const FTagStore::FPendingValue* FTagStore::FindPending(const TArray<FPendingValue>& Values, const FString& TagType, const FString& TagKey)
+{
+	return Values.FindByPredicate([&](const FPendingValue& Value) { return Value.Key == TagKey && Value.TagType == TagType; });
+}
+
+// Store the pending value and notify the tag listeners
+void FTagStore::SetPending(UObject* Owner, const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bRemoved)
+{
+	{
+		FRWScopeLock WriteLock(Lock, SLT_Write);
+		TArray<FPendingValue>& Values = Pending.FindOrAdd(Owner);
+		if (FPendingValue* Existing = FindPending(Values, TagType, TagKey))
+		{
+			// Assigning reuses the string allocation
+			Existing->Value.Reset();
+			Existing->Value.AppendChars(TagValue.Data, TagValue.Len);
+			Existing->bRemoved = bRemoved;
+		}
+		else
+		{
+			Values.Add(FPendingValue{ TagType, TagKey, TagValue.ToString(), bRemoved });
+		}
+	}
+	FTags::OnTagsChanged().Broadcast(Owner);
+}
+
+// Write the values to the tags of the owner
+int32 FTagStore::WriteValues(UObject* Owner, const TArray<FPendingValue>& Values)
+{
+	TUniquePtr<FTagEditor> Editor;
+	if (AActor* Actor = Cast<AActor>(Owner))
+	{
+		Editor = MakeUnique<FTagEditor>(Actor);
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Owner))
+	{
+		Editor = MakeUnique<FTagEditor>(Component);
+	}
+	else
+	{
+		return 0;
+	}
+
+	for (const auto& Value : Values)
+	{
+		if (Value.bRemoved)
+		{
+			Editor->RemoveKeyValuePair(Value.TagType, Value.Key);
+		}
+		else
+		{
+			Editor->AddKeyValuePair(Value.TagType, Value.Key, Value.Value, true);
+		}
+	}
+	Editor->Commit();
+	return Values.Num();
+}
+
+// Flush the objects which are saved
+void FTagStore::OnObjectSaved(UObject* Object)
+{
+	Flush(Object);
+}
+
+// Drop the pending values of the destroyed (collected) objects
+void FTagStore::OnPostGarbageCollect()
+{
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	for (auto It = Pending.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+#if WITH_EDITOR
+// Flush the objects selected in the editor, so the Details panel shows their values
+void FTagStore::OnObjectSelected(UObject* Object)
+{
+	Flush(Object);
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			Flush(Component);
+		}
+	}
+}
+#endif // WITH_EDITOR
+
+// Access to the store instance
+TUniquePtr<FTagStore>& FTagStore::GetInstance()
+{
+	static TUniquePtr<FTagStore> Instance;
+	return Instance;
+}
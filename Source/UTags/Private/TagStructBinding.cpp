@@ -0,0 +1,259 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagStructBinding.h"
+#include "TagEditor.h"
+#include "TagStore.h"
+#include "TagTokenizer.h"
+#include "TagTypeRegistry.h"
+#include "TagValue.h"
+#include "TagStats.h"
+#include "UTags.h"
+#include "UObject/UnrealType.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace
+{
+	// Lock of the cached layouts
+	FRWLock& GetLayoutLock()
+	{
+		static FRWLock Lock;
+		return Lock;
+	}
+
+	// Check if the value can be stored in a tag (it may not contain the pair or tag separators)
+	FORCEINLINE bool IsValidTagValue(const FString& InValue)
+	{
+		int32 Idx;
+		return !InValue.FindChar(TEXT(','), Idx) && !InValue.FindChar(TEXT(';'), Idx);
+	}
+}
+
+// Fill the struct fields from the tag type key value pairs in a single parse, returns the number of set fields
+int32 FTagStructBinding::Read(const TArray<FName>& InTags, const FString& TagType, const UScriptStruct* Struct, void* OutData, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(ReadStruct);
+	if (Struct == nullptr || OutData == nullptr)
+	{
+		return 0;
+	}
+
+	const int32 TagIndex = FTagTypeRegistry::Get().GetTagTypeIndex(InTags, TagType);
+	if (TagIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	const FLayout& Layout = GetLayout(Struct);
+	FTagNameBuffer TagBuffer(InTags[TagIndex]);
+	FTagTokenizer Tokenizer(TagBuffer.GetView());
+
+	// Reused null terminated copy of the text values
+	FString ValueText;
+	int32 NumSet = 0;
+	FTagView Key, Value;
+
+	// The pending tag store values of the owner override the pairs of the tag
+	const FTagStore* Store = FTagStore::Get();
+	if (Owner && Store && Store->HasPending(Owner))
+	{
+		TMap<FString, FString> KeyValuePairs;
+		while (Tokenizer.Next(Key, Value))
+		{
+			if (!Key.IsEmpty() && !Value.IsEmpty())
+			{
+				KeyValuePairs.Emplace(Key.ToString(), Value.ToString());
+			}
+		}
+		Store->ApplyPending(Owner, TagType, KeyValuePairs);
+		for (const auto& KV : KeyValuePairs)
+		{
+			if (ReadField(Layout, FTagView(KV.Key), FTagView(KV.Value), OutData, ValueText))
+			{
+				++NumSet;
+			}
+		}
+		return NumSet;
+	}
+
+	while (Tokenizer.Next(Key, Value))
+	{
+		if (ReadField(Layout, Key, Value, OutData, ValueText))
+		{
+			++NumSet;
+		}
+	}
+	return NumSet;
+}
+
+// Set the field bound to the key from the text value, false if there is no such field or the value is invalid
+bool FTagStructBinding::ReadField(const FLayout& Layout, const FTagView& Key, const FTagView& Value, void* OutData, FString& ValueText)
+{
+	const FField* Field = Layout.Fields.FindByPredicate([&Key](const FField& Candidate) { return Key.Equals(Candidate.Key); });
+	if (Field == nullptr)
+	{
+		return false;
+	}
+
+	void* ValuePtr = Field->Property->ContainerPtrToValuePtr<void>(OutData);
+	switch (Field->Kind)
+	{
+	case EFieldKind::Vector:
+		return FTagValue::Parse(Value, *static_cast<FVector*>(ValuePtr));
+	case EFieldKind::Quat:
+		return FTagValue::Parse(Value, *static_cast<FQuat*>(ValuePtr));
+	case EFieldKind::Transform:
+		return FTagValue::Parse(Value, *static_cast<FTransform*>(ValuePtr));
+	default:
+		ValueText.Reset(Value.Len);
+		ValueText.AppendChars(Value.Data, Value.Len);
+		return Field->Property->ImportText(*ValueText, ValuePtr, PPF_None, nullptr) != nullptr;
+	}
+}
+
+// Write the struct fields as key value pairs of the tag type, committed as one tag, false if nothing changed
+bool FTagStructBinding::Write(TArray<FName>& InTags, const FString& TagType, const UScriptStruct* Struct, const void* InData, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(WriteStruct);
+	FTagEditor Editor(InTags, Owner);
+	return WriteFields(Editor, TagType, Struct, InData) && Editor.Commit() > 0;
+}
+
+// Write the struct fields as key value pairs of the actor tag type
+bool FTagStructBinding::Write(AActor* Actor, const FString& TagType, const UScriptStruct* Struct, const void* InData)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(WriteStruct);
+	if (Actor == nullptr)
+	{
+		return false;
+	}
+	FTagEditor Editor(Actor);
+	return WriteFields(Editor, TagType, Struct, InData) && Editor.Commit() > 0;
+}
+
+// Write the struct fields as key value pairs of the component tag type
+bool FTagStructBinding::Write(UActorComponent* Component, const FString& TagType, const UScriptStruct* Struct, const void* InData)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(WriteStruct);
+	if (Component == nullptr)
+	{
+		return false;
+	}
+	FTagEditor Editor(Component);
+	return WriteFields(Editor, TagType, Struct, InData) && Editor.Commit() > 0;
+}
+
+// Access to the cached layouts
+TMap<const UScriptStruct*, TUniquePtr<FTagStructBinding::FLayout>>& FTagStructBinding::GetLayouts()
+{
+	static TMap<const UScriptStruct*, TUniquePtr<FLayout>> Layouts;
+	return Layouts;
+}
+
+// Get the cached layout of the struct, computed on first use
+const FTagStructBinding::FLayout& FTagStructBinding::GetLayout(const UScriptStruct* Struct)
+{
+	{
+		FRWScopeLock ReadLock(GetLayoutLock(), SLT_ReadOnly);
+		const TUniquePtr<FLayout>* Cached = GetLayouts().Find(Struct);
+		if (Cached && (*Cached)->Struct.Get() == Struct)
+		{
+			return **Cached;
+		}
+	}
+
+	// Compute the layout, a stale entry (struct destroyed and its address reused) is replaced
+	FRWScopeLock WriteLock(GetLayoutLock(), SLT_Write);
+	TUniquePtr<FLayout>& Layout = GetLayouts().FindOrAdd(Struct);
+	if (!Layout.IsValid() || Layout->Struct.Get() != Struct)
+	{
+		Layout = MakeUnique<FLayout>();
+		BuildLayout(Struct, *Layout);
+	}
+	return *Layout;
+}
+
+// Compute the bound fields of the struct
+void FTagStructBinding::BuildLayout(const UScriptStruct* Struct, FLayout& OutLayout)
+{
+	OutLayout.Struct = Struct;
+	for (TFieldIterator<UProperty> PropItr(Struct); PropItr; ++PropItr)
+	{
+		UProperty* Property = *PropItr;
+		EFieldKind Kind = EFieldKind::Text;
+		if (Property->ArrayDim != 1
+			|| Property->IsA(UArrayProperty::StaticClass())
+			|| Property->IsA(UMapProperty::StaticClass())
+			|| Property->IsA(USetProperty::StaticClass()))
+		{
+			continue;
+		}
+		else if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+		{
+			if (StructProperty->Struct == TBaseStructure<FVector>::Get())
+			{
+				Kind = EFieldKind::Vector;
+			}
+			else if (StructProperty->Struct == TBaseStructure<FQuat>::Get())
+			{
+				Kind = EFieldKind::Quat;
+			}
+			else if (StructProperty->Struct == TBaseStructure<FTransform>::Get())
+			{
+				Kind = EFieldKind::Transform;
+			}
+			else
+			{
+				continue;
+			}
+		}
+		OutLayout.Fields.Add(FField{ Property->GetName(), Property, Kind });
+	}
+}
+
+// Write the fields into the editor
+bool FTagStructBinding::WriteFields(FTagEditor& Editor, const FString& TagType, const UScriptStruct* Struct, const void* InData)
+{
+	if (Struct == nullptr || InData == nullptr)
+	{
+		return false;
+	}
+
+	const FLayout& Layout = GetLayout(Struct);
+	FTagValue::FBuffer Buffer;
+	// Reused by all fields, resetting keeps the allocation
+	FString ValueText;
+	for (const FField& Field : Layout.Fields)
+	{
+		const void* ValuePtr = Field.Property->ContainerPtrToValuePtr<void>(InData);
+		ValueText.Reset();
+		switch (Field.Kind)
+		{
+		case EFieldKind::Vector:
+			FTagValue::Format(*static_cast<const FVector*>(ValuePtr), Buffer);
+			ValueText.AppendChars(Buffer.Data, Buffer.Len);
+			break;
+		case EFieldKind::Quat:
+			FTagValue::Format(*static_cast<const FQuat*>(ValuePtr), Buffer);
+			ValueText.AppendChars(Buffer.Data, Buffer.Len);
+			break;
+		case EFieldKind::Transform:
+			FTagValue::Format(*static_cast<const FTransform*>(ValuePtr), Buffer);
+			ValueText.AppendChars(Buffer.Data, Buffer.Len);
+			break;
+		default:
+			Field.Property->ExportTextItem(ValueText, ValuePtr, nullptr, nullptr, PPF_None);
+			break;
+		}
+
+		// Skip the values which would break the tag format
+		if (!IsValidTagValue(ValueText))
+		{
+			UE_LOG(LogTags, Warning, TEXT("%s::%d Value of %s.%s contains tag separators, skipped.."),
+				*FString(__func__), __LINE__, *Struct->GetName(), *Field.Key);
+			continue;
+		}
+		Editor.AddKeyValuePair(TagType, Field.Key, ValueText, true);
+	}
+	return Editor.HasChanges();
+}
@@ -0,0 +1,52 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagTokenizer.h"
+#include "TagStats.h"
+
+namespace
+{
+	// Thread local pool of reused name buffers
+	struct FTagNameBufferPool
+	{
+		static constexpr int32 MaxDepth = 8;
+		FString Buffers[MaxDepth];
+		int32 Depth = 0;
+	};
+
+	FTagNameBufferPool& GetBufferPool()
+	{
+		static thread_local FTagNameBufferPool Pool;
+		return Pool;
+	}
+}
+
+// Copy the name into a free buffer
+FTagNameBuffer::FTagNameBuffer(const FName& InName)
+{
+	FTagNameBufferPool& Pool = GetBufferPool();
+	if (Pool.Depth < FTagNameBufferPool::MaxDepth)
+	{
+		Buffer = &Pool.Buffers[Pool.Depth++];
+		bPooled = true;
+	}
+	else
+	{
+		Buffer = &Fallback;
+		bPooled = false;
+	}
+
+	// Reset keeps the allocated slack, appending only reallocates for longer names
+	Buffer->Reset();
+	InName.AppendString(*Buffer);
+	UTAGS_STAT_TAGS_PARSED(1);
+}
+
+// Release the buffer
+FTagNameBuffer::~FTagNameBuffer()
+{
+	if (bPooled)
+	{
+		--GetBufferPool().Depth;
+	}
+}
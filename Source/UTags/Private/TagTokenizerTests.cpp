@@ -0,0 +1,95 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Tags.h"
+#include "TagAllocCounter.h"
+
+namespace
+{
+	// Number of calls per measured query
+	constexpr int32 NumQueryCalls = 64;
+
+	// Allocations of the calling thread while running the query, after a warm up call (caches, statics)
+	template<typename FunctorType>
+	int64 CountQueryAllocs(FTagAllocCounter& Counter, FunctorType&& Functor)
+	{
+		Functor();
+		Counter.Start();
+		for (int32 Call = 0; Call < NumQueryCalls; ++Call)
+		{
+			Functor();
+		}
+		return Counter.Stop();
+	}
+}
+
+/**
+* The FName tag queries run on views over a stack copy of the name, they must not touch the heap
+* (GetValue only allocates the returned string)
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTagTokenizerZeroAllocTest, "UTags.Tokenizer.ZeroAllocation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FTagTokenizerZeroAllocTest::RunTest(const FString& Parameters)
+{
+	// Wraps the global allocator for this test only, the previous allocator is restored when the scope ends
+	FTagAllocCounterScope CounterScope;
+	FTagAllocCounter* Counter = CounterScope.Get();
+	if (Counter == nullptr)
+	{
+		AddError(TEXT("The allocation counter could not be installed"));
+		return false;
+	}
+
+	// Names and query strings are created before counting
+	const FName Tag(TEXT("SemLog;Id,vxYjpPUfkEKDPo2SrQAT9g;Class,Cup;Mass,0.25;"));
+	const TArray<FName> Tags = { FName(TEXT("Other;Key,Value;")), Tag };
+	const FString TagType(TEXT("SemLog"));
+	const FString ClassKey(TEXT("Class"));
+	const FString ClassValue(TEXT("cup"));
+	const FString OtherValue(TEXT("Bowl"));
+	const FString MissingKey(TEXT("Color"));
+	const FString MassKey(TEXT("Mass"));
+
+	bool bHasPair = false;
+	int64 NumAllocs = CountQueryAllocs(*Counter, [&]() { bHasPair = FTags::HasKeyValuePair(Tag, ClassKey, ClassValue); });
+	TestTrue(TEXT("HasKeyValuePair(FName) finds the pair (ignoring case)"), bHasPair);
+	TestEqual(TEXT("HasKeyValuePair(FName) allocations"), NumAllocs, int64(0));
+
+	NumAllocs = CountQueryAllocs(*Counter, [&]() { bHasPair = FTags::HasKeyValuePair(Tag, ClassKey, OtherValue); });
+	TestFalse(TEXT("HasKeyValuePair(FName) rejects another value"), bHasPair);
+	TestEqual(TEXT("HasKeyValuePair(FName) mismatch allocations"), NumAllocs, int64(0));
+
+	NumAllocs = CountQueryAllocs(*Counter, [&]() { bHasPair = FTags::HasKeyValuePair(Tags, TagType, ClassKey, ClassValue); });
+	TestTrue(TEXT("HasKeyValuePair(TArray<FName>) finds the pair"), bHasPair);
+	TestEqual(TEXT("HasKeyValuePair(TArray<FName>) allocations"), NumAllocs, int64(0));
+
+	bool bHasKey = false;
+	NumAllocs = CountQueryAllocs(*Counter, [&]() { bHasKey = FTags::HasKey(Tag, ClassKey) && FTags::HasType(Tag, TagType); });
+	TestTrue(TEXT("HasKey/HasType(FName) find the key and type"), bHasKey);
+	TestEqual(TEXT("HasKey/HasType(FName) allocations"), NumAllocs, int64(0));
+
+	// A missing key returns an empty string, nothing is allocated
+	FString Value;
+	NumAllocs = CountQueryAllocs(*Counter, [&]() { Value = FTags::GetValue(Tag, MissingKey); });
+	TestTrue(TEXT("GetValue(FName) of a missing key is empty"), Value.IsEmpty());
+	TestEqual(TEXT("GetValue(FName) missing key allocations"), NumAllocs, int64(0));
+
+	// A found value only allocates the returned string
+	NumAllocs = CountQueryAllocs(*Counter, [&]() { Value = FTags::GetValue(Tag, ClassKey); });
+	TestEqual(TEXT("GetValue(FName) returns the value"), Value, FString(TEXT("Cup")));
+	TestTrue(TEXT("GetValue(FName) only allocates the returned string"), NumAllocs <= NumQueryCalls);
+
+	float Mass = 0.f;
+	bool bHasMass = false;
+	NumAllocs = CountQueryAllocs(*Counter, [&]() { bHasMass = FTags::GetValueAsFloat(Tag, MassKey, Mass); });
+	TestTrue(TEXT("GetValueAsFloat(FName) parses the value"), bHasMass && FMath::IsNearlyEqual(Mass, 0.25f));
+	TestEqual(TEXT("GetValueAsFloat(FName) allocations"), NumAllocs, int64(0));
+
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
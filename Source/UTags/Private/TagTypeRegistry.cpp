@@ -0,0 +1,285 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagTypeRegistry.h"
+#include "Tags.h"
+#include "TagTokenizer.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	// Cached id of untyped tags, they do not contribute to the masks
+	constexpr int32 UntypedId = -2;
+}
+
+// Get the module wide registry
+FTagTypeRegistry& FTagTypeRegistry::Get()
+{
+	static FTagTypeRegistry Registry;
+	return Registry;
+}
+
+// Register to the tags changed and garbage collection events
+FTagTypeRegistry::FTagTypeRegistry()
+{
+	FTags::OnTagsChanged().AddRaw(this, &FTagTypeRegistry::InvalidateObject);
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FTagTypeRegistry::OnPostGarbageCollect);
+}
+
+// Get the id of the type, registers it if needed, INDEX_NONE if all ids are in use
+int32 FTagTypeRegistry::RegisterType(const FString& TagType)
+{
+	const int32 ExistingId = FindTypeId(TagType);
+	if (ExistingId != INDEX_NONE)
+	{
+		return ExistingId;
+	}
+
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	if (const int32* TypeId = TypeIds.Find(TagType))
+	{
+		return *TypeId;
+	}
+	if (TypeIds.Num() >= MaxTypeIds)
+	{
+		return INDEX_NONE;
+	}
+	return TypeIds.Add(TagType, TypeIds.Num());
+}
+
+// Get the id of a registered type, INDEX_NONE if not registered
+int32 FTagTypeRegistry::FindTypeId(const FString& TagType) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	const int32* TypeId = TypeIds.Find(TagType);
+	return TypeId ? *TypeId : INDEX_NONE;
+}
+
+// Get the type id of the tag, INDEX_NONE if it is untyped or its type has no id
+int32 FTagTypeRegistry::GetTagTypeId(const FName& InTag)
+{
+	const int32 TypeId = FindOrAddTagTypeId(InTag);
+	return TypeId == UntypedId ? INDEX_NONE : TypeId;
+}
+
+// Compute the type mask of the tags
+FTagTypeRegistry::FTypeMask FTagTypeRegistry::GetTypeMask(const TArray<FName>& InTags)
+{
+	FTypeMask Mask = 0;
+	for (const auto& TagItr : InTags)
+	{
+		// Untyped tags have no type, types without an id set the overflow bit
+		const int32 TypeId = FindOrAddTagTypeId(TagItr);
+		if (TypeId != UntypedId)
+		{
+			Mask |= ToMask(TypeId);
+		}
+	}
+	return Mask;
+}
+
+// Get the cached type mask of the actor or component
+FTagTypeRegistry::FTypeMask FTagTypeRegistry::GetObjectTypeMask(UObject* Object)
+{
+	const TArray<FName>* ObjectTags = GetObjectTags(Object);
+	if (ObjectTags == nullptr)
+	{
+		return 0;
+	}
+	const uint32 TagsHash = HashTags(*ObjectTags);
+	{
+		FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+		const FObjectMask* Cached = ObjectMasks.Find(Object);
+		if (Cached && Cached->TagsHash == TagsHash)
+		{
+			return Cached->Mask;
+		}
+	}
+	return FindOrAddObjectTypeMask(Object, *ObjectTags, TagsHash);
+}
+
+// Check if the actor or component has a tag of the type (a bit test for types with an id)
+bool FTagTypeRegistry::HasType(UObject* Object, const FString& TagType)
+{
+	const TArray<FName>* ObjectTags = GetObjectTags(Object);
+	if (ObjectTags == nullptr)
+	{
+		return false;
+	}
+
+	FTypeMask Mask = 0;
+	int32 TypeId = INDEX_NONE;
+	const uint32 TagsHash = HashTags(*ObjectTags);
+	if (!FindCachedMask(Object, TagsHash, TagType, Mask, TypeId))
+	{
+		// Computing the mask registers the types of the object tags
+		Mask = FindOrAddObjectTypeMask(Object, *ObjectTags, TagsHash);
+		TypeId = FindTypeId(TagType);
+	}
+	if (TypeId != INDEX_NONE)
+	{
+		return (Mask & ToMask(TypeId)) != 0;
+	}
+	// Unknown type, or a type without an id carried by the object
+	return (Mask & OverflowBit) != 0 && GetTagTypeIndex(*ObjectTags, TagType) != INDEX_NONE;
+}
+
+// Return the index of the first tag of the type in the tags array, INDEX_NONE if not found
+int32 FTagTypeRegistry::GetTagTypeIndex(const TArray<FName>& InTags, const FString& TagType)
+{
+	int32 TypeId = INDEX_NONE;
+	for (int32 i = 0; i < InTags.Num(); ++i)
+	{
+		// The tag ids also register the types of the iterated tags
+		const int32 TagTypeId = FindOrAddTagTypeId(InTags[i]);
+		if (TagTypeId == UntypedId)
+		{
+			continue;
+		}
+		else if (TagTypeId == INDEX_NONE)
+		{
+			// Type without an id, compare the strings
+			FTagNameBuffer TagBuffer(InTags[i]);
+			if (FTagTokenizer(TagBuffer.GetView()).IsType(TagType))
+			{
+				return i;
+			}
+			continue;
+		}
+
+		// Resolve the queried type once it could have been registered
+		if (TypeId == INDEX_NONE)
+		{
+			TypeId = FindTypeId(TagType);
+		}
+		if (TagTypeId == TypeId)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+// Return the index of the first tag of the type of the actor or component, INDEX_NONE if not found
+int32 FTagTypeRegistry::GetTagTypeIndex(UObject* Object, const FString& TagType)
+{
+	const TArray<FName>* ObjectTags = GetObjectTags(Object);
+	if (ObjectTags == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	FTypeMask Mask = 0;
+	int32 TypeId = INDEX_NONE;
+	const uint32 TagsHash = HashTags(*ObjectTags);
+	if (!FindCachedMask(Object, TagsHash, TagType, Mask, TypeId))
+	{
+		// Computing the mask registers the types of the object tags
+		Mask = FindOrAddObjectTypeMask(Object, *ObjectTags, TagsHash);
+		TypeId = FindTypeId(TagType);
+	}
+	if ((Mask & ToMask(TypeId)) == 0)
+	{
+		return INDEX_NONE;
+	}
+	return GetTagTypeIndex(*ObjectTags, TagType);
+}
+
+// Get the cached type id of the tag (UntypedId for untyped tags), parses and caches it on a miss
+int32 FTagTypeRegistry::FindOrAddTagTypeId(const FName& InTag)
+{
+	{
+		FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+		if (const int32* CachedId = NameTypeIds.Find(InTag))
+		{
+			return *CachedId;
+		}
+	}
+
+	FTagNameBuffer TagBuffer(InTag);
+	const FTagTokenizer Tokenizer(TagBuffer.GetView());
+	const int32 TypeId = Tokenizer.HasType() ? RegisterType(Tokenizer.GetType().ToString()) : UntypedId;
+
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	NameTypeIds.Add(InTag, TypeId);
+	return TypeId;
+}
+
+// Drop the cached type mask of the object
+void FTagTypeRegistry::InvalidateObject(UObject* Object)
+{
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	ObjectMasks.Remove(Object);
+}
+
+// Drop all cached names and masks (the type ids are kept)
+void FTagTypeRegistry::Empty()
+{
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	NameTypeIds.Empty();
+	ObjectMasks.Empty();
+}
+
+// Get the tags array of an actor or component, nullptr otherwise
+const TArray<FName>* FTagTypeRegistry::GetObjectTags(UObject* Object)
+{
+	if (AActor* Act = Cast<AActor>(Object))
+	{
+		return &Act->Tags;
+	}
+	else if (UActorComponent* ActComp = Cast<UActorComponent>(Object))
+	{
+		return &ActComp->ComponentTags;
+	}
+	return nullptr;
+}
+
+// Hash of the tag names (name indices only, no string access)
+uint32 FTagTypeRegistry::HashTags(const TArray<FName>& InTags)
+{
+	// The display index keeps the case, the type ids of the names are case sensitive
+	uint32 Hash = InTags.Num();
+	for (const auto& TagItr : InTags)
+	{
+		Hash = HashCombine(Hash, HashCombine(uint32(TagItr.GetDisplayIndex()), uint32(TagItr.GetNumber())));
+	}
+	return Hash;
+}
+
+// Get the cached type mask and the id of the type under a single lock, false if the object mask is not cached or stale
+bool FTagTypeRegistry::FindCachedMask(UObject* Object, uint32 TagsHash, const FString& TagType, FTypeMask& OutMask, int32& OutTypeId) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	const FObjectMask* Cached = ObjectMasks.Find(Object);
+	if (Cached == nullptr || Cached->TagsHash != TagsHash)
+	{
+		return false;
+	}
+	const int32* TypeId = TypeIds.Find(TagType);
+	OutMask = Cached->Mask;
+	OutTypeId = TypeId ? *TypeId : INDEX_NONE;
+	return true;
+}
+
+// Get the type mask of the object tags, computes and caches it on a miss
+FTagTypeRegistry::FTypeMask FTagTypeRegistry::FindOrAddObjectTypeMask(UObject* Object, const TArray<FName>& InTags, uint32 TagsHash)
+{
+	const FTypeMask Mask = GetTypeMask(InTags);
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	ObjectMasks.Add(Object, FObjectMask{ Mask, TagsHash });
+	return Mask;
+}
+
+// Drop the masks of the collected objects
+void FTagTypeRegistry::OnPostGarbageCollect()
+{
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	for (auto It = ObjectMasks.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "TagValue.h"
+
+namespace
+{
+	// Longest accepted number text
+	constexpr int32 MaxNumberLen = 63;
+
+	// Skip the optional sign at the index
+	FORCEINLINE void SkipSign(const FTagView& InText, int32& Idx)
+	{
+		if (Idx < InText.Len && (InText.Data[Idx] == TEXT('-') || InText.Data[Idx] == TEXT('+')))
+		{
+			++Idx;
+		}
+	}
+
+	// Skip the digits at the index, returns their number
+	FORCEINLINE int32 SkipDigits(const FTagView& InText, int32& Idx)
+	{
+		const int32 Start = Idx;
+		while (Idx < InText.Len && FChar::IsDigit(InText.Data[Idx]))
+		{
+			++Idx;
+		}
+		return Idx - Start;
+	}
+
+	// Copy the number text into a null terminated stack buffer, false if it is not a well formed number
+	// integer: [sign]digits, with fraction: [sign]digits[.digits][(e|E)[sign]digits] or [sign].digits[..]
+	bool CopyNumber(const FTagView& InText, TCHAR(&OutBuffer)[MaxNumberLen + 1], bool bAllowFraction)
+	{
+		if (InText.IsEmpty() || InText.Len > MaxNumberLen)
+		{
+			return false;
+		}
+
+		int32 Idx = 0;
+		SkipSign(InText, Idx);
+		int32 NumMantissaDigits = SkipDigits(InText, Idx);
+		if (bAllowFraction && Idx < InText.Len && InText.Data[Idx] == TEXT('.'))
+		{
+			++Idx;
+			NumMantissaDigits += SkipDigits(InText, Idx);
+		}
+		if (NumMantissaDigits == 0)
+		{
+			return false;
+		}
+
+		// The exponent needs a mantissa digit before and at least one digit after
+		if (bAllowFraction && Idx < InText.Len && (InText.Data[Idx] == TEXT('e') || InText.Data[Idx] == TEXT('E')))
+		{
+			++Idx;
+			SkipSign(InText, Idx);
+			if (SkipDigits(InText, Idx) == 0)
+			{
+				return false;
+			}
+		}
+		if (Idx != InText.Len)
+		{
+			return false;
+		}
+
+		FMemory::Memcpy(OutBuffer, InText.Data, InText.Len * sizeof(TCHAR));
+		OutBuffer[InText.Len] = TEXT('\0');
+		return true;
+	}
+
+	// Append the formatted text to the buffer
+	template<typename... ArgTypes>
+	void AppendFormatted(FTagValue::FBuffer& OutBuffer, const TCHAR* Fmt, ArgTypes... Args)
+	{
+		const int32 Capacity = ARRAY_COUNT(OutBuffer.Data) - OutBuffer.Len;
+		const int32 Written = FCString::Snprintf(OutBuffer.Data + OutBuffer.Len, Capacity, Fmt, Args...);
+		OutBuffer.Len += FMath::Clamp(Written, 0, Capacity - 1);
+	}
+}
+
+// Parse an integer
+bool FTagValue::Parse(const FTagView& InText, int32& OutValue)
+{
+	TCHAR Buffer[MaxNumberLen + 1];
+	if (!CopyNumber(InText, Buffer, false))
+	{
+		return false;
+	}
+	const int64 Value = FCString::Atoi64(Buffer);
+	if (Value < MIN_int32 || Value > MAX_int32)
+	{
+		return false;
+	}
+	OutValue = static_cast<int32>(Value);
+	return true;
+}
+
+// Parse a float
+bool FTagValue::Parse(const FTagView& InText, float& OutValue)
+{
+	TCHAR Buffer[MaxNumberLen + 1];
+	if (!CopyNumber(InText, Buffer, true))
+	{
+		return false;
+	}
+	OutValue = static_cast<float>(FCString::Atod(Buffer));
+	return true;
+}
+
+// Parse a bool ("true"/"false" or "1"/"0", ignoring case)
+bool FTagValue::Parse(const FTagView& InText, bool& OutValue)
+{
+	if (InText.Equals(TEXT("true")) || InText.Equals(TEXT("1")))
+	{
+		OutValue = true;
+		return true;
+	}
+	else if (InText.Equals(TEXT("false")) || InText.Equals(TEXT("0")))
+	{
+		OutValue = false;
+		return true;
+	}
+	return false;
+}
+
+// Parse a vector
+bool FTagValue::Parse(const FTagView& InText, FVector& OutValue)
+{
+	float Values[3];
+	if (!ParseFloats(InText, Values, 3))
+	{
+		return false;
+	}
+	OutValue = FVector(Values[0], Values[1], Values[2]);
+	return true;
+}
+
+// Parse a quaternion
+bool FTagValue::Parse(const FTagView& InText, FQuat& OutValue)
+{
+	float Values[4];
+	if (!ParseFloats(InText, Values, 4))
+	{
+		return false;
+	}
+	OutValue = FQuat(Values[0], Values[1], Values[2], Values[3]);
+	return true;
+}
+
+// Parse a transform, the scale is optional
+bool FTagValue::Parse(const FTagView& InText, FTransform& OutValue)
+{
+	float Values[10] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f };
+	if (!ParseFloats(InText, Values, 10) && !ParseFloats(InText, Values, 7))
+	{
+		return false;
+	}
+	OutValue = FTransform(
+		FQuat(Values[3], Values[4], Values[5], Values[6]),
+		FVector(Values[0], Values[1], Values[2]),
+		FVector(Values[7], Values[8], Values[9]));
+	return true;
+}
+
+// Format an integer
+void FTagValue::Format(int32 InValue, FBuffer& OutBuffer)
+{
+	OutBuffer.Len = 0;
+	AppendFormatted(OutBuffer, TEXT("%d"), InValue);
+}
+
+// Format a float
+void FTagValue::Format(float InValue, FBuffer& OutBuffer)
+{
+	FormatFloats(&InValue, 1, OutBuffer);
+}
+
+// Format a bool
+void FTagValue::Format(bool InValue, FBuffer& OutBuffer)
+{
+	OutBuffer.Len = 0;
+	AppendFormatted(OutBuffer, TEXT("%s"), InValue ? TEXT("true") : TEXT("false"));
+}
+
+// Format a vector
+void FTagValue::Format(const FVector& InValue, FBuffer& OutBuffer)
+{
+	const float Values[3] = { InValue.X, InValue.Y, InValue.Z };
+	FormatFloats(Values, 3, OutBuffer);
+}
+
+// Format a quaternion
+void FTagValue::Format(const FQuat& InValue, FBuffer& OutBuffer)
+{
+	const float Values[4] = { InValue.X, InValue.Y, InValue.Z, InValue.W };
+	FormatFloats(Values, 4, OutBuffer);
+}
+
+// Format a transform, the scale is only written if it is not one
+void FTagValue::Format(const FTransform& InValue, FBuffer& OutBuffer)
+{
+	const FVector Loc = InValue.GetLocation();
+	const FQuat Rot = InValue.GetRotation();
+	const FVector Scale = InValue.GetScale3D();
+	const float Values[10] = { Loc.X, Loc.Y, Loc.Z, Rot.X, Rot.Y, Rot.Z, Rot.W, Scale.X, Scale.Y, Scale.Z };
+	FormatFloats(Values, Scale.Equals(FVector::OneVector, 0.f) ? 7 : 10, OutBuffer);
+}
+
+// Parse exactly Num separated floats
+bool FTagValue::ParseFloats(const FTagView& InText, float* OutValues, int32 Num)
+{
+	int32 Start = 0;
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		int32 End = InText.Find(Separator, Start);
+		if (End == INDEX_NONE)
+		{
+			End = InText.Len;
+		}
+		// The last value has to end the text, the others a separator
+		if ((Idx == Num - 1) != (End == InText.Len))
+		{
+			return false;
+		}
+		if (!Parse(FTagView(InText.Data + Start, End - Start), OutValues[Idx]))
+		{
+			return false;
+		}
+		Start = End + 1;
+	}
+	return true;
+}
+
+// Append separated floats
+void FTagValue::FormatFloats(const float* InValues, int32 Num, FBuffer& OutBuffer)
+{
+	OutBuffer.Len = 0;
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		// Nine significant digits round-trip any float
+		AppendFormatted(OutBuffer, Idx == 0 ? TEXT("%.9g") : TEXT("|%.9g"), InValues[Idx]);
+	}
+}
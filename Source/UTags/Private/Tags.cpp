@@ -2,69 +2,441 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Tags.h"
+#include "TagIndex.h"
+#include "TagTokenizer.h"
+#include "TagParseCache.h"
+#include "TagEditor.h"
+#include "TagTypeRegistry.h"
+#include "TagQuery.h"
+#include "TagStats.h"
+#include "TagValue.h"
+#include "TagStore.h"
+#include "TagSpatialIndex.h"
+#include "Ids.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
+#include "Misc/Optional.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Number of objects parsed by a parallel task
+	constexpr int32 ParallelChunkSize = 256;
+
+	// Collect the actors and/or components of the world, in the order of the serial world iteration
+	void GatherWorldObjects(UWorld* World, bool bActors, bool bComponents, TArray<UObject*>& OutObjects)
+	{
+		const int32 StartNum = OutObjects.Num();
+		for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+		{
+			if (bActors)
+			{
+				OutObjects.Add(*ActorItr);
+			}
+			if (bComponents)
+			{
+				for (const auto& CompItr : ActorItr->GetComponents())
+				{
+					OutObjects.Add(CompItr);
+				}
+			}
+		}
+		UTAGS_STAT_OBJECTS_VISITED(OutObjects.Num() - StartNum);
+	}
 
-///////////////////////////////////////////////////////////////////////////
-// Return the index where the tag type was found in the array
-int32 FTags::GetTagTypeIndex(const TArray<FName>& InTags, const FString& TagType)
-{
-	// Iterate all the tags, check for keyword TagType
-	for (int32 i = 0; i < InTags.Num(); ++i)
+	// Get the tags array of the actor or component
+	FORCEINLINE const TArray<FName>& GetObjectTags(UObject* Object)
+	{
+		if (AActor* Act = Cast<AActor>(Object))
+		{
+			return Act->Tags;
+		}
+		return CastChecked<UActorComponent>(Object)->ComponentTags;
+	}
+
+	// Parse the value of the key of the tag, without copying it
+	template<typename ValueType>
+	bool ParseTagValue(const FName& InTag, const FString& TagKey, ValueType& OutValue)
+	{
+		FTagNameBuffer TagBuffer(InTag);
+		FTagView Value;
+		return FTagTokenizer(TagBuffer.GetView()).FindValue(TagKey, Value) && FTagValue::Parse(Value, OutValue);
+	}
+
+	// Collect the objects with a numeric value of the tag type key
+	void GatherNumericValues(UWorld* World, const FString& TagType, const FString& TagKey, TArray<TPair<float, UObject*>>& OutValues)
+	{
+		FTags::ForEachObjectWithTag(World, TagType, TagKey, [&OutValues](UObject* Obj, const FTagView& Value)
+		{
+			float NumericValue;
+			if (FTagValue::Parse(Value, NumericValue))
+			{
+				OutValues.Emplace(NumericValue, Obj);
+			}
+			return true;
+		});
+	}
+
+	// Collect the objects with a value of the tag type key accepted by the predicate
+	template<typename PredicateType>
+	TArray<UObject*> GatherObjectsWithValue(UWorld* World, const FString& TagType, const FString& TagKey, PredicateType Predicate)
+	{
+		TArray<UObject*> Objects;
+		FTags::ForEachObjectWithTag(World, TagType, TagKey, [&](UObject* Obj, const FTagView& Value)
+		{
+			if (Predicate(Value))
+			{
+				Objects.Emplace(Obj);
+			}
+			return true;
+		});
+		return Objects;
+	}
+
+	// Get the pending value of the key from the tag store (if enabled), Set and Removed override the tags
+	FORCEINLINE FTagStore::EState FindStoredValue(UObject* Owner, const FString& TagType, const FString& TagKey, FString& OutValue)
+	{
+		const FTagStore* Store = FTagStore::Get();
+		return Store ? Store->FindValue(Owner, TagType, TagKey, OutValue) : FTagStore::EState::None;
+	}
+
+	// Parse the value of the key of the actor or component tag type, reading through the tag store
+	template<typename OwnerType, typename ValueType>
+	bool ParseObjectTagValue(OwnerType* Owner, const TArray<FName>& OwnerTags, const FString& TagType, const FString& TagKey, ValueType& OutValue)
+	{
+		FString StoredValue;
+		const FTagStore::EState State = FindStoredValue(Owner, TagType, TagKey, StoredValue);
+		if (State != FTagStore::EState::None)
+		{
+			return State == FTagStore::EState::Set && FTagValue::Parse(FTagView(*StoredValue, StoredValue.Len()), OutValue);
+		}
+		const int32 TagIndex = FTags::GetTagTypeIndex(Owner, TagType);
+		return TagIndex != INDEX_NONE && ParseTagValue(OwnerTags[TagIndex], TagKey, OutValue);
+	}
+
+	// Set the key value pair of the tag type (created if needed), existing types of actors and components
+	// are written to the tag store if enabled, the value view is only copied where it is stored
+	bool SetKeyValuePair(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting, UObject* Owner)
+	{
+		// Values of existing tag types of actors and components are kept in the tag store (if enabled), without creating new names
+		if (FTagStore* Store = FTagStore::Get())
+		{
+			if (FTagStore::IsOwnerTags(Owner, InTags) && FTags::GetTagTypeIndex(InTags, TagType) != INDEX_NONE)
+			{
+				return Store->SetValue(Owner, InTags, TagType, TagKey, TagValue, bReplaceExisting);
+			}
+		}
+
+		// The tag type is created if it does not exist
+		FTagEditor Editor(InTags, Owner);
+		const bool bAdded = Editor.AddKeyValuePair(TagType, TagKey, TagValue, bReplaceExisting);
+		Editor.Commit();
+		return bAdded;
+	}
+
+	// Set the key value pair of the actor or component tag type, false for other objects
+	bool SetObjectKeyValuePair(UObject* Object, const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting)
+	{
+		if (AActor* ObjAsAct = Cast<AActor>(Object))
+		{
+			return SetKeyValuePair(ObjAsAct->Tags, TagType, TagKey, TagValue, bReplaceExisting, ObjAsAct);
+		}
+		else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+		{
+			return SetKeyValuePair(ObjAsActComp->ComponentTags, TagType, TagKey, TagValue, bReplaceExisting, ObjAsActComp);
+		}
+		return false;
+	}
+
+	// Run the functor on every object across cores, each chunk writes its own slice of the results
+	template<typename ResultType, typename FunctorType>
+	void ParallelParseObjects(const TArray<UObject*>& Objects, TArray<ResultType>& OutResults, FunctorType Functor)
+	{
+		OutResults.SetNum(Objects.Num());
+		const int32 NumChunks = FMath::DivideAndRoundUp(Objects.Num(), ParallelChunkSize);
+		UTAGS_STAT_PARALLEL_SCOPE(StatScope);
+		ParallelFor(NumChunks, [&](int32 ChunkIdx)
+		{
+			UTAGS_STAT_TASK_SCOPE(StatScope);
+			const int32 Start = ChunkIdx * ParallelChunkSize;
+			const int32 End = FMath::Min(Start + ParallelChunkSize, Objects.Num());
+			for (int32 Idx = Start; Idx < End; ++Idx)
+			{
+				OutResults[Idx] = Functor(Objects[Idx]);
+			}
+		});
+	}
+
+	// Hash set sharded by hash, safe to insert from multiple threads, strings are compared
+	// case insensitive (same as the tag values, ids differing only in case are duplicates)
+	class FConcurrentStringSet
 	{
-		// Check if tag is of given type
-		if (InTags[i].ToString().StartsWith(TagType + ";"))
+	public:
+		// Insert the string, false if it (or a differently cased copy) was already in the set
+		bool Add(const FString& InString)
 		{
-			return i;
+			FShard& Shard = Shards[GetTypeHash(InString) % NumShards];
+			FScopeLock ScopeLock(&Shard.Lock);
+			bool bAlreadyInSet = false;
+			Shard.Set.Add(InString, &bAlreadyInSet);
+			return !bAlreadyInSet;
 		}
+
+	private:
+		static constexpr uint32 NumShards = 64;
+
+		struct FShard
+		{
+			FCriticalSection Lock;
+			TSet<FString> Set;
+		};
+		FShard Shards[NumShards];
+	};
+
+	// Parse the key value pairs of the objects in parallel, merge the non empty results in order
+	template<typename ObjectType>
+	TMap<ObjectType*, TMap<FString, FString>> ParallelKeyValuePairs(UWorld* World, const FString& TagType, bool bActors, bool bComponents)
+	{
+		TArray<UObject*> Objects;
+		GatherWorldObjects(World, bActors, bComponents, Objects);
+
+		TArray<TMap<FString, FString>> Results;
+		ParallelParseObjects(Objects, Results, [&TagType](UObject* Object)
+		{
+			// Reads through the tag store (its lookups are thread safe)
+			return FTags::GetKeyValuePairs(Object, TagType);
+		});
+
+		TMap<ObjectType*, TMap<FString, FString>> ObjectToTagProperties;
+		for (int32 Idx = 0; Idx < Objects.Num(); ++Idx)
+		{
+			// If object has tag type and at least one property
+			if (Results[Idx].Num() > 0)
+			{
+				ObjectToTagProperties.Emplace(static_cast<ObjectType*>(Objects[Idx]), MoveTemp(Results[Idx]));
+			}
+		}
+		return ObjectToTagProperties;
+	}
+
+	// Collect the objects with the tag type key and their values, sorted by object index
+	TTagObjectResults<FString> KeyValueDense(UWorld* World, const FString& TagType, const FString& TagKey, bool bActors, bool bComponents)
+	{
+		TTagObjectResults<FString> Results;
+		if (const FTagIndex* Index = FTagIndex::Get(World))
+		{
+			Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+			{
+				if (Obj->IsA(AActor::StaticClass()) ? bActors : bComponents)
+				{
+					Results.Add(Obj, Value);
+				}
+			});
+		}
+		else
+		{
+			for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+			{
+				UTAGS_STAT_OBJECTS_VISITED(1);
+				if (bActors)
+				{
+					FString ActValue = FTags::GetValue(*ActorItr, TagType, TagKey);
+					if (!ActValue.IsEmpty())
+					{
+						Results.Add(*ActorItr, MoveTemp(ActValue));
+					}
+				}
+				if (bComponents)
+				{
+					for (const auto& CompItr : ActorItr->GetComponents())
+					{
+						UTAGS_STAT_OBJECTS_VISITED(1);
+						FString CompValue = FTags::GetValue(CompItr, TagType, TagKey);
+						if (!CompValue.IsEmpty())
+						{
+							Results.Add(CompItr, MoveTemp(CompValue));
+						}
+					}
+				}
+			}
+		}
+		Results.SortByObjectIndex();
+		return Results;
+	}
+
+	// Copy of the tags of an actor or component and of its pending tag store values, safe to read off the game thread
+	struct FCapturedTags
+	{
+		TWeakObjectPtr<UObject> Object;
+		TArray<FName> Tags;
+		TArray<FTagStore::FPendingValue> PendingValues;
+	};
+
+	// Copy the tags of the world objects, objects without tags are skipped
+	TArray<FCapturedTags> CaptureWorldTags(UWorld* World, bool bActors, bool bComponents)
+	{
+		check(IsInGameThread());
+		TArray<UObject*> Objects;
+		GatherWorldObjects(World, bActors, bComponents, Objects);
+
+		// The pending values of the tag store (if enabled) are copied with the tags, the world is left untouched
+		const FTagStore* Store = FTagStore::Get();
+
+		TArray<FCapturedTags> Captured;
+		Captured.Reserve(Objects.Num());
+		for (UObject* Object : Objects)
+		{
+			const TArray<FName>& ObjectTags = GetObjectTags(Object);
+			if (ObjectTags.Num() > 0)
+			{
+				FCapturedTags& Item = Captured.Add_GetRef(FCapturedTags{ Object, ObjectTags });
+				if (Store)
+				{
+					Store->CopyPending(Object, Item.PendingValues);
+				}
+			}
+		}
+		return Captured;
+	}
+
+	// Capture the world tags and run the query on them on the task graph, the result is passed to the functor on the task thread
+	template<typename ResultType, typename QueryType>
+	void RunAsyncQuery(UWorld* World, bool bActors, bool bComponents, QueryType Query, TFunction<void(ResultType&&)> OnResult)
+	{
+		const TSharedRef<const TArray<FCapturedTags>, ESPMode::ThreadSafe> Captured =
+			MakeShared<const TArray<FCapturedTags>, ESPMode::ThreadSafe>(CaptureWorldTags(World, bActors, bComponents));
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Captured, Query, OnResult]()
+		{
+			OnResult(Query(*Captured));
+		});
+	}
+
+	// Run the query asynchronously, the future is fulfilled on the task thread
+	template<typename ResultType, typename QueryType>
+	TFuture<ResultType> AsyncQueryFuture(UWorld* World, bool bActors, bool bComponents, QueryType Query)
+	{
+		const TSharedRef<TPromise<ResultType>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<ResultType>, ESPMode::ThreadSafe>();
+		TFuture<ResultType> Future = Promise->GetFuture();
+		RunAsyncQuery<ResultType>(World, bActors, bComponents, Query, [Promise](ResultType&& Result)
+		{
+			Promise->SetValue(MoveTemp(Result));
+		});
+		return Future;
+	}
+
+	// Run the query asynchronously, the callback is called with the result on the game thread
+	template<typename ResultType, typename QueryType>
+	void AsyncQueryCallback(UWorld* World, bool bActors, bool bComponents, QueryType Query, TFunction<void(const ResultType&)> OnComplete)
+	{
+		RunAsyncQuery<ResultType>(World, bActors, bComponents, Query, [OnComplete](ResultType&& Result)
+		{
+			AsyncTask(ENamedThreads::GameThread, [OnComplete, Result = MoveTemp(Result)]()
+			{
+				OnComplete(Result);
+			});
+		});
+	}
+
+	// Async query of the objects to tag key value
+	auto MakeObjectsToKeyValueQuery(const FString& TagType, const FString& TagKey)
+	{
+		return [TagType, TagKey](const TArray<FCapturedTags>& Captured)
+		{
+			TMap<TWeakObjectPtr<UObject>, FString> ObjectsToKeyValue;
+			for (const auto& Item : Captured)
+			{
+				// Read through the copied pending values, same as FTags::GetValue of the object
+				FString Value;
+				const FTagStore::EState State = FTagStore::FindValue(Item.PendingValues, TagType, TagKey, Value);
+				if (State == FTagStore::EState::None)
+				{
+					Value = FTags::GetValue(Item.Tags, TagType, TagKey);
+				}
+				if (State != FTagStore::EState::Removed && !Value.IsEmpty())
+				{
+					ObjectsToKeyValue.Emplace(Item.Object, MoveTemp(Value));
+				}
+			}
+			return ObjectsToKeyValue;
+		};
+	}
+
+	// Async query of the objects to tag key value pairs
+	auto MakeObjectKeyValuePairsMapQuery(const FString& TagType)
+	{
+		return [TagType](const TArray<FCapturedTags>& Captured)
+		{
+			TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>> ObjectToKeyValuePairs;
+			for (const auto& Item : Captured)
+			{
+				TMap<FString, FString> KeyValuePairs = FTags::GetKeyValuePairs(Item.Tags, TagType);
+				FTagStore::ApplyPending(Item.PendingValues, TagType, KeyValuePairs);
+				if (KeyValuePairs.Num() > 0)
+				{
+					ObjectToKeyValuePairs.Emplace(Item.Object, MoveTemp(KeyValuePairs));
+				}
+			}
+			return ObjectToKeyValuePairs;
+		};
 	}
-	// return INDEX_NONE if type was not found 
-	return INDEX_NONE;
 
-	//// Init tag index
-	//int32 TagIndex = INDEX_NONE;
+	// Async query of the objects matching the tag query
+	auto MakeObjectsWithQuery(const FTagQuery& Query)
+	{
+		return [Query](const TArray<FCapturedTags>& Captured)
+		{
+			TArray<TWeakObjectPtr<UObject>> Objects;
+			for (const auto& Item : Captured)
+			{
+				if (Query.Matches(Item.Tags, Item.PendingValues))
+				{
+					Objects.Emplace(Item.Object);
+				}
+			}
+			return Objects;
+		};
+	}
+}
 
-	//// Iterate all the tags, check for keyword TagType
-	//for (const auto& TagItr : InTags)
-	//{
-	//	// Increment the position of the tag in the array
-	//	++TagIndex;
+///////////////////////////////////////////////////////////////////////////
+// Event triggered after an actor or component tags were changed by the FTags mutators
+FOnTagsChanged& FTags::OnTagsChanged()
+{
+	static FOnTagsChanged TagsChangedEvent;
+	return TagsChangedEvent;
+}
 
-	//	// Check if tag is of given type
-	//	if (TagItr.ToString().StartsWith(TagType + ";"))
-	//	{
-	//		return TagIndex;
-	//	}
-	//}
-	//// return INDEX_NONE if type was not found 
-	//return INDEX_NONE;
+///////////////////////////////////////////////////////////////////////////
+// Return the index where the tag type was found in the array
+int32 FTags::GetTagTypeIndex(const TArray<FName>& InTags, const FString& TagType)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetTagTypeIndex);
+	// Compare the cached type ids of the tags
+	return FTagTypeRegistry::Get().GetTagTypeIndex(InTags, TagType);
 }
 
 // Return the index where the tag type was found in the actor's array
 int32 FTags::GetTagTypeIndex(AActor* Actor, const FString& TagType)
 {
-	return GetTagTypeIndex(Actor->Tags, TagType);
+	UTAGS_SCOPE_CYCLE_COUNTER(GetTagTypeIndex);
+	// The cached type mask of the actor rejects missing types with a bit test
+	return FTagTypeRegistry::Get().GetTagTypeIndex(Actor, TagType);
 }
 
 // Return the index where the tag type was found in the component's array
 int32 FTags::GetTagTypeIndex(UActorComponent* Component, const FString& TagType)
 {
-	return GetTagTypeIndex(Component->ComponentTags, TagType);
+	UTAGS_SCOPE_CYCLE_COUNTER(GetTagTypeIndex);
+	// The cached type mask of the component rejects missing types with a bit test
+	return FTagTypeRegistry::Get().GetTagTypeIndex(Component, TagType);
 }
 
 // Return the index where the tag type was found in the object
 int32 FTags::GetTagTypeIndex(UObject* Object, const FString& TagType)
 {
-	if (UActorComponent* ActComp = Cast<UActorComponent>(Object))
-	{
-		return GetTagTypeIndex(ActComp->ComponentTags, TagType);
-	}
-	else if (AActor* Act = Cast<AActor>(Object))
-	{
-		return GetTagTypeIndex(Act->Tags, TagType);
-	}
-	else
-	{
-		return INDEX_NONE;
-	}	
+	UTAGS_SCOPE_CYCLE_COUNTER(GetTagTypeIndex);
+	// Returns INDEX_NONE if the object is not an actor or component
+	return FTagTypeRegistry::Get().GetTagTypeIndex(Object, TagType);
 }
 
 
@@ -72,38 +444,44 @@ int32 FTags::GetTagTypeIndex(UObject* Object, const FString& TagType)
 // Check if type exists in tag
 bool FTags::HasType(const FName& InTag, const FString& TagType)
 {
-	return InTag.ToString().StartsWith(TagType + ";");
+	UTAGS_SCOPE_CYCLE_COUNTER(HasType);
+	FTagNameBuffer TagBuffer(InTag);
+	return FTagTokenizer(TagBuffer.GetView()).IsType(TagType);
 }
 
 // Check if type exists in tag array
 bool FTags::HasType(const TArray<FName>& InTags, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasType);
 	return FTags::GetTagTypeIndex(InTags, TagType) != INDEX_NONE;
 }
 
 // Check if type exists from actor
 bool FTags::HasType(AActor* Actor, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasType);
 	if (Actor == nullptr)
 	{
 		return false;
 	}
-	return FTags::HasType(Actor->Tags, TagType);
+	return FTagTypeRegistry::Get().HasType(Actor, TagType);
 }
 
 // Check if type exists from component
 bool FTags::HasType(UActorComponent* Component, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasType);
 	if (Component == nullptr)
 	{
 		return false;
 	}
-	return FTags::HasType(Component->ComponentTags, TagType);
+	return FTagTypeRegistry::Get().HasType(Component, TagType);
 }
 
 // Check if type exists from object
 bool FTags::HasType(UObject* Object, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasType);
 	if (Object == nullptr)
 	{
 		return false;
@@ -128,17 +506,24 @@ bool FTags::HasType(UObject* Object, const FString& TagType)
 // Check if key exists in tag
 bool FTags::HasKey(const FName& InTag, const FString& TagKey)
 {
-	return InTag.ToString().Find(";" + TagKey + ",") != INDEX_NONE;
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKey);
+	FTagNameBuffer TagBuffer(InTag);
+	return FTagTokenizer(TagBuffer.GetView()).HasKey(TagKey);
 }
 
 // Check if key exists tag array
 bool FTags::HasKey(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex != INDEX_NONE)
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKey);
+	// Check the key in the first tag of the given type
+	for (const auto& TagItr : InTags)
 	{
-		return FTags::HasKey(InTags[TagIndex], TagKey);
+		FTagNameBuffer TagBuffer(TagItr);
+		const FTagTokenizer Tokenizer(TagBuffer.GetView());
+		if (Tokenizer.IsType(TagType))
+		{
+			return Tokenizer.HasKey(TagKey);
+		}
 	}
 	// Type was not found, return false
 	return false;
@@ -147,26 +532,43 @@ bool FTags::HasKey(const TArray<FName>& InTags, const FString& TagType, const FS
 // Check if key exists from actor
 bool FTags::HasKey(AActor* Actor, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKey);
 	if (Actor == nullptr)
 	{
 		return false;
 	}
-	return FTags::HasKey(Actor->Tags, TagType, TagKey);
+	FString StoredValue;
+	const FTagStore::EState State = FindStoredValue(Actor, TagType, TagKey, StoredValue);
+	if (State != FTagStore::EState::None)
+	{
+		return State == FTagStore::EState::Set;
+	}
+	const int32 TagIndex = FTags::GetTagTypeIndex(Actor, TagType);
+	return TagIndex != INDEX_NONE && FTags::HasKey(Actor->Tags[TagIndex], TagKey);
 }
 
 // Check if key exists from component
 bool FTags::HasKey(UActorComponent* Component, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKey);
 	if (Component == nullptr)
 	{
 		return false;
 	}
-	return FTags::HasKey(Component->ComponentTags, TagType, TagKey);
+	FString StoredValue;
+	const FTagStore::EState State = FindStoredValue(Component, TagType, TagKey, StoredValue);
+	if (State != FTagStore::EState::None)
+	{
+		return State == FTagStore::EState::Set;
+	}
+	const int32 TagIndex = FTags::GetTagTypeIndex(Component, TagType);
+	return TagIndex != INDEX_NONE && FTags::HasKey(Component->ComponentTags[TagIndex], TagKey);
 }
 
 // Check if key exists from object
 bool FTags::HasKey(UObject* Object, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKey);
 	if (Object == nullptr)
 	{
 		return false;
@@ -190,17 +592,24 @@ bool FTags::HasKey(UObject* Object, const FString& TagType, const FString& TagKe
 // Check if key value pair exists in tag
 bool FTags::HasKeyValuePair(const FName& InTag, const FString& TagKey, const FString& TagValue)
 {
-	return InTag.ToString().Find(";" + TagKey + "," + TagValue + ";") != INDEX_NONE;
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKeyValuePair);
+	FTagNameBuffer TagBuffer(InTag);
+	return FTagTokenizer(TagBuffer.GetView()).HasKeyValuePair(TagKey, TagValue);
 }
 
 // Check if key value pair exists in tag array
 bool FTags::HasKeyValuePair(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FString& TagValue)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex != INDEX_NONE)
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKeyValuePair);
+	// Check the key value pair in the first tag of the given type
+	for (const auto& TagItr : InTags)
 	{
-		return FTags::HasKeyValuePair(InTags[TagIndex], TagKey, TagValue);
+		FTagNameBuffer TagBuffer(TagItr);
+		const FTagTokenizer Tokenizer(TagBuffer.GetView());
+		if (Tokenizer.IsType(TagType))
+		{
+			return Tokenizer.HasKeyValuePair(TagKey, TagValue);
+		}
 	}
 	// Type was not found, return false
 	return false;
@@ -209,26 +618,43 @@ bool FTags::HasKeyValuePair(const TArray<FName>& InTags, const FString& TagType,
 // Check if key value pair exists in actor tags
 bool FTags::HasKeyValuePair(AActor* Actor, const FString& TagType, const FString& TagKey, const FString& TagValue)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKeyValuePair);
 	if (Actor == nullptr)
 	{
 		return false;
 	}
-	return FTags::HasKeyValuePair(Actor->Tags, TagType, TagKey, TagValue);
+	FString StoredValue;
+	const FTagStore::EState State = FindStoredValue(Actor, TagType, TagKey, StoredValue);
+	if (State != FTagStore::EState::None)
+	{
+		return State == FTagStore::EState::Set && StoredValue == TagValue;
+	}
+	const int32 TagIndex = FTags::GetTagTypeIndex(Actor, TagType);
+	return TagIndex != INDEX_NONE && FTags::HasKeyValuePair(Actor->Tags[TagIndex], TagKey, TagValue);
 }
 
 // Check if key value pair exists in component tags
 bool FTags::HasKeyValuePair(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FString& TagValue)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKeyValuePair);
 	if (Component == nullptr)
 	{
 		return false;
 	}
-	return FTags::HasKeyValuePair(Component->ComponentTags, TagType, TagKey, TagValue);
+	FString StoredValue;
+	const FTagStore::EState State = FindStoredValue(Component, TagType, TagKey, StoredValue);
+	if (State != FTagStore::EState::None)
+	{
+		return State == FTagStore::EState::Set && StoredValue == TagValue;
+	}
+	const int32 TagIndex = FTags::GetTagTypeIndex(Component, TagType);
+	return TagIndex != INDEX_NONE && FTags::HasKeyValuePair(Component->ComponentTags[TagIndex], TagKey, TagValue);
 }
 
 // Check if key value pair exists in object
 bool FTags::HasKeyValuePair(UObject* Object, const FString& TagType, const FString& TagKey, const FString& TagValue)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(HasKeyValuePair);
 	if (Object == nullptr)
 	{
 		return false;
@@ -252,18 +678,13 @@ bool FTags::HasKeyValuePair(UObject* Object, const FString& TagType, const FStri
 // Get tag key value from tag
 FString FTags::GetValue(const FName& InTag, const FString& TagKey)
 {
-	// Copy of the current tag as FString
-	FString CurrTag = InTag.ToString();
-
-	// Check the position of the key string in the tag
-	int32 KeyPos = CurrTag.Find(";" + TagKey + ",");
-	if (KeyPos != INDEX_NONE)
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValue);
+	// Only the returned value is allocated
+	FTagNameBuffer TagBuffer(InTag);
+	FTagView Value;
+	if (FTagTokenizer(TagBuffer.GetView()).FindValue(TagKey, Value))
 	{
-		// Remove from tag with the cut length of: 
-		// pos of the key + length of the semicolon char + length of the key + length of the comma char 
-		CurrTag.RemoveAt(0, KeyPos + 1 + TagKey.Len() + 1);
-		// Set the tag value as the left side of the string before the semicolon
-		return CurrTag.Left(CurrTag.Find(";"));
+		return Value.ToString();
 	}
 	// Return empty string if key was not found
 	return FString();
@@ -272,11 +693,17 @@ FString FTags::GetValue(const FName& InTag, const FString& TagKey)
 // Get tag key value from tag array
 FString FTags::GetValue(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex != INDEX_NONE)
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValue);
+	// Get the value from the first tag of the given type
+	for (const auto& TagItr : InTags)
 	{
-		return FTags::GetValue(InTags[TagIndex], TagKey);
+		FTagNameBuffer TagBuffer(TagItr);
+		const FTagTokenizer Tokenizer(TagBuffer.GetView());
+		if (Tokenizer.IsType(TagType))
+		{
+			FTagView Value;
+			return Tokenizer.FindValue(TagKey, Value) ? Value.ToString() : FString();
+		}
 	}
 
 	// If type was not found return an empty string
@@ -286,206 +713,690 @@ FString FTags::GetValue(const TArray<FName>& InTags, const FString& TagType, con
 // Get tag key value from actor
 FString FTags::GetValue(AActor* Actor, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValue);
 	if (Actor == nullptr)
 	{
 		return FString();
 	}
-	return FTags::GetValue(Actor->Tags, TagType, TagKey);
+	FString StoredValue;
+	const FTagStore::EState State = FindStoredValue(Actor, TagType, TagKey, StoredValue);
+	if (State != FTagStore::EState::None)
+	{
+		return StoredValue;
+	}
+	const int32 TagIndex = FTags::GetTagTypeIndex(Actor, TagType);
+	return TagIndex != INDEX_NONE ? FTags::GetValue(Actor->Tags[TagIndex], TagKey) : FString();
 }
 
 // Get tag key value from component
 FString FTags::GetValue(UActorComponent* Component, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValue);
 	if (Component == nullptr)
 	{
 		return FString();
 	}
-	return FTags::GetValue(Component->ComponentTags, TagType, TagKey);
+	FString StoredValue;
+	const FTagStore::EState State = FindStoredValue(Component, TagType, TagKey, StoredValue);
+	if (State != FTagStore::EState::None)
+	{
+		return StoredValue;
+	}
+	const int32 TagIndex = FTags::GetTagTypeIndex(Component, TagType);
+	return TagIndex != INDEX_NONE ? FTags::GetValue(Component->ComponentTags[TagIndex], TagKey) : FString();
 }
 
 // Get tag key value from object
 FString FTags::GetValue(UObject* Object, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValue);
 	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		return GetValue(ObjAsAct->Tags, TagType, TagKey);
+		return GetValue(ObjAsAct, TagType, TagKey);
 	}
 	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
 	{
-		return GetValue(ObjAsActComp->ComponentTags, TagType, TagKey);
+		return GetValue(ObjAsActComp, TagType, TagKey);
 	}
 	return FString();
 }
 
 ///////////////////////////////////////////////////////////////////////////
-// Add tag key value from tags, if bReplaceExisting is true, replace existing value
-bool FTags::AddKeyValuePair(FName& InTag, const FString& TagKey, const FString& TagValue, bool bReplaceExisting, UObject* Owner)
+// Get the value of the key of the tag as an integer
+bool FTags::GetValueAsInt(const FName& InTag, const FString& TagKey, int32& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsInt);
+	return ParseTagValue(InTag, TagKey, OutValue);
+}
+
+// Get the value of the key of the tag type as an integer
+bool FTags::GetValueAsInt(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, int32& OutValue)
 {
-	// Get the key value
-	const FString CurrVal = FTags::GetValue(InTag, TagKey);
-	if (CurrVal.IsEmpty())
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsInt);
+	const int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
+	return TagIndex != INDEX_NONE && ParseTagValue(InTags[TagIndex], TagKey, OutValue);
+}
+
+// Get the value of the key of the actor tag type as an integer
+bool FTags::GetValueAsInt(AActor* Actor, const FString& TagType, const FString& TagKey, int32& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsInt);
+	if (Actor == nullptr)
 	{
-		if (Owner)
-		{
-			Owner->Modify();
-		}
-		// Key does not exist, add new one at the end
-		InTag = FName(*InTag.ToString().Append(TagKey).Append(",").Append(TagValue).Append(";"));
-		return true;
+		return false;
 	}
-	else if (bReplaceExisting)
+	return ParseObjectTagValue(Actor, Actor->Tags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the component tag type as an integer
+bool FTags::GetValueAsInt(UActorComponent* Component, const FString& TagType, const FString& TagKey, int32& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsInt);
+	if (Component == nullptr)
 	{
-		if (Owner)
-		{
-			Owner->Modify();
-		}
-		// Key exist, replace
-		const FString Old = TagKey + "," + CurrVal;
-		const FString New = TagKey + "," + TagValue;
-		InTag = FName(*InTag.ToString().Replace(*Old, *New));
-		InTag = FName(*InTag.ToString().Replace(*CurrVal, *TagValue));
-		return true;
+		return false;
 	}
-	// Cannot overwrite value, return false
-	return false;
+	return ParseObjectTagValue(Component, Component->ComponentTags, TagType, TagKey, OutValue);
 }
 
-// Add tag key value from tags, if bReplaceExisting is true, replace existing value
-bool FTags::AddKeyValuePair(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting, UObject* Owner)
+// Get the value of the key of the object tag type as an integer
+bool FTags::GetValueAsInt(UObject* Object, const FString& TagType, const FString& TagKey, int32& OutValue)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex != INDEX_NONE)
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsInt);
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		return FTags::AddKeyValuePair(InTags[TagIndex], TagKey, TagValue, bReplaceExisting, Owner);
+		return FTags::GetValueAsInt(ObjAsAct, TagType, TagKey, OutValue);
 	}
-	else // Type was not found, create a new one
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
 	{
-		if (Owner)
-		{
-			Owner->Modify();
-		}
-		FString NewTag;
-		InTags.Add(FName(*NewTag.Append(TagType).Append(";").Append(TagKey).Append(",").Append(TagValue).Append(";")));
-		return true;
+		return FTags::GetValueAsInt(ObjAsActComp, TagType, TagKey, OutValue);
 	}
 	return false;
 }
 
-// Add tag key value to actor, if bReplaceExisting is true, replace existing value
-bool FTags::AddKeyValuePair(AActor* Actor, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting)
+// Get the value of the key of the tag as a float
+bool FTags::GetValueAsFloat(const FName& InTag, const FString& TagKey, float& OutValue)
 {
-	return FTags::AddKeyValuePair(Actor->Tags, TagType, TagKey, TagValue, bReplaceExisting, Actor);
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsFloat);
+	return ParseTagValue(InTag, TagKey, OutValue);
 }
 
-// Add tag key value to component, if bReplaceExisting is true, replace existing value
-bool FTags::AddKeyValuePair(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting)
+// Get the value of the key of the tag type as a float
+bool FTags::GetValueAsFloat(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, float& OutValue)
 {
-	return FTags::AddKeyValuePair(Component->ComponentTags, TagType, TagKey, TagValue, bReplaceExisting, Component);
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsFloat);
+	const int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
+	return TagIndex != INDEX_NONE && ParseTagValue(InTags[TagIndex], TagKey, OutValue);
 }
 
-// Add tag key value to object, if bReplaceExisting is true, replace existing value
-bool FTags::AddKeyValuePair(UObject* Object, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting)
+// Get the value of the key of the actor tag type as a float
+bool FTags::GetValueAsFloat(AActor* Actor, const FString& TagType, const FString& TagKey, float& OutValue)
 {
-	if (AActor* ObjAsAct = Cast<AActor>(Object))
-	{
-		return FTags::AddKeyValuePair(ObjAsAct->Tags, TagType, TagKey, TagValue, bReplaceExisting);
-	}
-	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsFloat);
+	if (Actor == nullptr)
 	{
-		return FTags::AddKeyValuePair(ObjAsActComp->ComponentTags, TagType, TagKey, TagValue, bReplaceExisting);
+		return false;
 	}
-	return false;
+	return ParseObjectTagValue(Actor, Actor->Tags, TagType, TagKey, OutValue);
 }
 
-
-///////////////////////////////////////////////////////////////////////////
-//Add array of tag key values to tag, if bReplaceExisting is true, replace existing value
-bool FTags::AddKeyValuePairs(FName& InTag, const TArray<TPair<FString, FString>>& InKeyValuePairs, bool bReplaceExisting, UObject* Owner)
+// Get the value of the key of the component tag type as a float
+bool FTags::GetValueAsFloat(UActorComponent* Component, const FString& TagType, const FString& TagKey, float& OutValue)
 {
-	bool bAllKeyValuePairsAdded = true;
-	for (const auto& KV : InKeyValuePairs)
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsFloat);
+	if (Component == nullptr)
 	{
-		// Get the key value
-		const FString CurrVal = FTags::GetValue(InTag, KV.Key);
-		if (CurrVal.IsEmpty())
-		{
-			if (Owner)
-			{
-				Owner->Modify();
-			}
-			// Key does not exist, add new one at the end
-			InTag = FName(*InTag.ToString().Append(KV.Key).Append(",").Append(KV.Value).Append(";"));
-		}
-		else if (bReplaceExisting)
-		{
-			if (Owner)
-			{
-				Owner->Modify();
-			}
-			// Key exist, replace
-			const FString Old = KV.Key + "," + CurrVal;
-			const FString New = KV.Key + "," + KV.Value;
-			InTag = FName(*InTag.ToString().Replace(*Old, *New));
-		}
-		else
-		{
-			// Could not overwrite value
-			bAllKeyValuePairsAdded = false;
-		}
+		return false;
 	}
-	return bAllKeyValuePairsAdded;
+	return ParseObjectTagValue(Component, Component->ComponentTags, TagType, TagKey, OutValue);
 }
 
-// Add array of tag key values to tags, if bReplaceExisting is true, replace existing value
-bool FTags::AddKeyValuePairs(TArray<FName>& InTags, const FString& TagType, const TArray<TPair<FString, FString>>& InKeyValuePairs, bool bReplaceExisting, UObject* Owner)
+// Get the value of the key of the object tag type as a float
+bool FTags::GetValueAsFloat(UObject* Object, const FString& TagType, const FString& TagKey, float& OutValue)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex != INDEX_NONE)
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsFloat);
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		return FTags::AddKeyValuePairs(InTags[TagIndex], InKeyValuePairs, bReplaceExisting);
+		return FTags::GetValueAsFloat(ObjAsAct, TagType, TagKey, OutValue);
 	}
-	else // Type was not found, create a new one
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
 	{
-		if (Owner)
-		{
-			Owner->Modify();
-		}
-		FString NewTag;
-		NewTag.Append(TagType).Append(";");
-		for (const auto& TagKeyVal : InKeyValuePairs)
-		{
-			NewTag.Append(TagKeyVal.Key).Append(",").Append(TagKeyVal.Value).Append(";");
-		}
-		InTags.Add(FName(*NewTag));
-		return true;
+		return FTags::GetValueAsFloat(ObjAsActComp, TagType, TagKey, OutValue);
+	}
+	return false;
+}
+
+// Get the value of the key of the tag as a bool
+bool FTags::GetValueAsBool(const FName& InTag, const FString& TagKey, bool& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsBool);
+	return ParseTagValue(InTag, TagKey, OutValue);
+}
+
+// Get the value of the key of the tag type as a bool
+bool FTags::GetValueAsBool(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, bool& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsBool);
+	const int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
+	return TagIndex != INDEX_NONE && ParseTagValue(InTags[TagIndex], TagKey, OutValue);
+}
+
+// Get the value of the key of the actor tag type as a bool
+bool FTags::GetValueAsBool(AActor* Actor, const FString& TagType, const FString& TagKey, bool& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsBool);
+	if (Actor == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Actor, Actor->Tags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the component tag type as a bool
+bool FTags::GetValueAsBool(UActorComponent* Component, const FString& TagType, const FString& TagKey, bool& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsBool);
+	if (Component == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Component, Component->ComponentTags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the object tag type as a bool
+bool FTags::GetValueAsBool(UObject* Object, const FString& TagType, const FString& TagKey, bool& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsBool);
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
+	{
+		return FTags::GetValueAsBool(ObjAsAct, TagType, TagKey, OutValue);
+	}
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+	{
+		return FTags::GetValueAsBool(ObjAsActComp, TagType, TagKey, OutValue);
+	}
+	return false;
+}
+
+// Get the value of the key of the tag as a vector (X|Y|Z)
+bool FTags::GetValueAsVector(const FName& InTag, const FString& TagKey, FVector& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsVector);
+	return ParseTagValue(InTag, TagKey, OutValue);
+}
+
+// Get the value of the key of the tag type as a vector (X|Y|Z)
+bool FTags::GetValueAsVector(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, FVector& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsVector);
+	const int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
+	return TagIndex != INDEX_NONE && ParseTagValue(InTags[TagIndex], TagKey, OutValue);
+}
+
+// Get the value of the key of the actor tag type as a vector (X|Y|Z)
+bool FTags::GetValueAsVector(AActor* Actor, const FString& TagType, const FString& TagKey, FVector& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsVector);
+	if (Actor == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Actor, Actor->Tags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the component tag type as a vector (X|Y|Z)
+bool FTags::GetValueAsVector(UActorComponent* Component, const FString& TagType, const FString& TagKey, FVector& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsVector);
+	if (Component == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Component, Component->ComponentTags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the object tag type as a vector (X|Y|Z)
+bool FTags::GetValueAsVector(UObject* Object, const FString& TagType, const FString& TagKey, FVector& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsVector);
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
+	{
+		return FTags::GetValueAsVector(ObjAsAct, TagType, TagKey, OutValue);
+	}
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+	{
+		return FTags::GetValueAsVector(ObjAsActComp, TagType, TagKey, OutValue);
+	}
+	return false;
+}
+
+// Get the value of the key of the tag as a quaternion (X|Y|Z|W)
+bool FTags::GetValueAsQuat(const FName& InTag, const FString& TagKey, FQuat& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsQuat);
+	return ParseTagValue(InTag, TagKey, OutValue);
+}
+
+// Get the value of the key of the tag type as a quaternion (X|Y|Z|W)
+bool FTags::GetValueAsQuat(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, FQuat& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsQuat);
+	const int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
+	return TagIndex != INDEX_NONE && ParseTagValue(InTags[TagIndex], TagKey, OutValue);
+}
+
+// Get the value of the key of the actor tag type as a quaternion (X|Y|Z|W)
+bool FTags::GetValueAsQuat(AActor* Actor, const FString& TagType, const FString& TagKey, FQuat& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsQuat);
+	if (Actor == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Actor, Actor->Tags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the component tag type as a quaternion (X|Y|Z|W)
+bool FTags::GetValueAsQuat(UActorComponent* Component, const FString& TagType, const FString& TagKey, FQuat& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsQuat);
+	if (Component == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Component, Component->ComponentTags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the object tag type as a quaternion (X|Y|Z|W)
+bool FTags::GetValueAsQuat(UObject* Object, const FString& TagType, const FString& TagKey, FQuat& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsQuat);
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
+	{
+		return FTags::GetValueAsQuat(ObjAsAct, TagType, TagKey, OutValue);
+	}
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+	{
+		return FTags::GetValueAsQuat(ObjAsActComp, TagType, TagKey, OutValue);
+	}
+	return false;
+}
+
+// Get the value of the key of the tag as a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ])
+bool FTags::GetValueAsTransform(const FName& InTag, const FString& TagKey, FTransform& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsTransform);
+	return ParseTagValue(InTag, TagKey, OutValue);
+}
+
+// Get the value of the key of the tag type as a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ])
+bool FTags::GetValueAsTransform(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, FTransform& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsTransform);
+	const int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
+	return TagIndex != INDEX_NONE && ParseTagValue(InTags[TagIndex], TagKey, OutValue);
+}
+
+// Get the value of the key of the actor tag type as a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ])
+bool FTags::GetValueAsTransform(AActor* Actor, const FString& TagType, const FString& TagKey, FTransform& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsTransform);
+	if (Actor == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Actor, Actor->Tags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the component tag type as a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ])
+bool FTags::GetValueAsTransform(UActorComponent* Component, const FString& TagType, const FString& TagKey, FTransform& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsTransform);
+	if (Component == nullptr)
+	{
+		return false;
+	}
+	return ParseObjectTagValue(Component, Component->ComponentTags, TagType, TagKey, OutValue);
+}
+
+// Get the value of the key of the object tag type as a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ])
+bool FTags::GetValueAsTransform(UObject* Object, const FString& TagType, const FString& TagKey, FTransform& OutValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetValueAsTransform);
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
+	{
+		return FTags::GetValueAsTransform(ObjAsAct, TagType, TagKey, OutValue);
+	}
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+	{
+		return FTags::GetValueAsTransform(ObjAsActComp, TagType, TagKey, OutValue);
 	}
 	return false;
 }
 
+// Add the key with an integer value to the tag type
+bool FTags::AddKeyValuePairAsInt(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsInt);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(InTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Owner);
+}
+
+// Add the key with an integer value to the actor tag type
+bool FTags::AddKeyValuePairAsInt(AActor* Actor, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsInt);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Actor->Tags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Actor);
+}
+
+// Add the key with an integer value to the component tag type
+bool FTags::AddKeyValuePairAsInt(UActorComponent* Component, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsInt);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Component->ComponentTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Component);
+}
+
+// Add the key with an integer value to the object tag type
+bool FTags::AddKeyValuePairAsInt(UObject* Object, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsInt);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetObjectKeyValuePair(Object, TagType, TagKey, Buffer.GetView(), bReplaceExisting);
+}
+
+// Add the key with a float value to the tag type
+bool FTags::AddKeyValuePairAsFloat(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsFloat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(InTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Owner);
+}
+
+// Add the key with a float value to the actor tag type
+bool FTags::AddKeyValuePairAsFloat(AActor* Actor, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsFloat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Actor->Tags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Actor);
+}
+
+// Add the key with a float value to the component tag type
+bool FTags::AddKeyValuePairAsFloat(UActorComponent* Component, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsFloat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Component->ComponentTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Component);
+}
+
+// Add the key with a float value to the object tag type
+bool FTags::AddKeyValuePairAsFloat(UObject* Object, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsFloat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetObjectKeyValuePair(Object, TagType, TagKey, Buffer.GetView(), bReplaceExisting);
+}
+
+// Add the key with a bool value to the tag type
+bool FTags::AddKeyValuePairAsBool(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsBool);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(InTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Owner);
+}
+
+// Add the key with a bool value to the actor tag type
+bool FTags::AddKeyValuePairAsBool(AActor* Actor, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsBool);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Actor->Tags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Actor);
+}
+
+// Add the key with a bool value to the component tag type
+bool FTags::AddKeyValuePairAsBool(UActorComponent* Component, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsBool);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Component->ComponentTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Component);
+}
+
+// Add the key with a bool value to the object tag type
+bool FTags::AddKeyValuePairAsBool(UObject* Object, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsBool);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetObjectKeyValuePair(Object, TagType, TagKey, Buffer.GetView(), bReplaceExisting);
+}
+
+// Add the key with a vector (X|Y|Z) value to the tag type
+bool FTags::AddKeyValuePairAsVector(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsVector);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(InTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Owner);
+}
+
+// Add the key with a vector (X|Y|Z) value to the actor tag type
+bool FTags::AddKeyValuePairAsVector(AActor* Actor, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsVector);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Actor->Tags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Actor);
+}
+
+// Add the key with a vector (X|Y|Z) value to the component tag type
+bool FTags::AddKeyValuePairAsVector(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsVector);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Component->ComponentTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Component);
+}
+
+// Add the key with a vector (X|Y|Z) value to the object tag type
+bool FTags::AddKeyValuePairAsVector(UObject* Object, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsVector);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetObjectKeyValuePair(Object, TagType, TagKey, Buffer.GetView(), bReplaceExisting);
+}
+
+// Add the key with a quaternion (X|Y|Z|W) value to the tag type
+bool FTags::AddKeyValuePairAsQuat(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsQuat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(InTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Owner);
+}
+
+// Add the key with a quaternion (X|Y|Z|W) value to the actor tag type
+bool FTags::AddKeyValuePairAsQuat(AActor* Actor, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsQuat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Actor->Tags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Actor);
+}
+
+// Add the key with a quaternion (X|Y|Z|W) value to the component tag type
+bool FTags::AddKeyValuePairAsQuat(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsQuat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Component->ComponentTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Component);
+}
+
+// Add the key with a quaternion (X|Y|Z|W) value to the object tag type
+bool FTags::AddKeyValuePairAsQuat(UObject* Object, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsQuat);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetObjectKeyValuePair(Object, TagType, TagKey, Buffer.GetView(), bReplaceExisting);
+}
+
+// Add the key with a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ]) value to the tag type
+bool FTags::AddKeyValuePairAsTransform(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsTransform);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(InTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Owner);
+}
+
+// Add the key with a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ]) value to the actor tag type
+bool FTags::AddKeyValuePairAsTransform(AActor* Actor, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsTransform);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Actor->Tags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Actor);
+}
+
+// Add the key with a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ]) value to the component tag type
+bool FTags::AddKeyValuePairAsTransform(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsTransform);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetKeyValuePair(Component->ComponentTags, TagType, TagKey, Buffer.GetView(), bReplaceExisting, Component);
+}
+
+// Add the key with a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ]) value to the object tag type
+bool FTags::AddKeyValuePairAsTransform(UObject* Object, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairAsTransform);
+	FTagValue::FBuffer Buffer;
+	FTagValue::Format(TagValue, Buffer);
+	return SetObjectKeyValuePair(Object, TagType, TagKey, Buffer.GetView(), bReplaceExisting);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+// Add tag key value from tags, if bReplaceExisting is true, replace existing value
+bool FTags::AddKeyValuePair(FName& InTag, const FString& TagKey, const FString& TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePair);
+	FTagEditor Editor(InTag, Owner);
+	const bool bAdded = Editor.AddKeyValuePair(0, TagKey, TagValue, bReplaceExisting);
+	Editor.Commit();
+	return bAdded;
+}
+
+// Add tag key value from tags, if bReplaceExisting is true, replace existing value
+bool FTags::AddKeyValuePair(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePair);
+	return SetKeyValuePair(InTags, TagType, TagKey, TagValue, bReplaceExisting, Owner);
+}
+
+// Add tag key value to actor, if bReplaceExisting is true, replace existing value
+bool FTags::AddKeyValuePair(AActor* Actor, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePair);
+	return FTags::AddKeyValuePair(Actor->Tags, TagType, TagKey, TagValue, bReplaceExisting, Actor);
+}
+
+// Add tag key value to component, if bReplaceExisting is true, replace existing value
+bool FTags::AddKeyValuePair(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePair);
+	return FTags::AddKeyValuePair(Component->ComponentTags, TagType, TagKey, TagValue, bReplaceExisting, Component);
+}
+
+// Add tag key value to object, if bReplaceExisting is true, replace existing value
+bool FTags::AddKeyValuePair(UObject* Object, const FString& TagType, const FString& TagKey, const FString& TagValue, bool bReplaceExisting)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePair);
+	if (AActor* ObjAsAct = Cast<AActor>(Object))
+	{
+		return FTags::AddKeyValuePair(ObjAsAct, TagType, TagKey, TagValue, bReplaceExisting);
+	}
+	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+	{
+		return FTags::AddKeyValuePair(ObjAsActComp, TagType, TagKey, TagValue, bReplaceExisting);
+	}
+	return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//Add array of tag key values to tag, if bReplaceExisting is true, replace existing value
+bool FTags::AddKeyValuePairs(FName& InTag, const TArray<TPair<FString, FString>>& InKeyValuePairs, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
+	// All pairs are applied in memory, the tag is written once
+	FTagEditor Editor(InTag, Owner);
+	bool bAllKeyValuePairsAdded = true;
+	for (const auto& KV : InKeyValuePairs)
+	{
+		// Could not overwrite value
+		bAllKeyValuePairsAdded &= Editor.AddKeyValuePair(0, KV.Key, KV.Value, bReplaceExisting);
+	}
+	Editor.Commit();
+	return bAllKeyValuePairsAdded;
+}
+
+// Add array of tag key values to tags, if bReplaceExisting is true, replace existing value
+bool FTags::AddKeyValuePairs(TArray<FName>& InTags, const FString& TagType, const TArray<TPair<FString, FString>>& InKeyValuePairs, bool bReplaceExisting, UObject* Owner)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
+	// All pairs are applied in memory, the tag is written once (and created if needed)
+	FTagEditor Editor(InTags, Owner);
+	bool bAllKeyValuePairsAdded = true;
+	for (const auto& KV : InKeyValuePairs)
+	{
+		// Could not overwrite value
+		bAllKeyValuePairsAdded &= Editor.AddKeyValuePair(TagType, KV.Key, KV.Value, bReplaceExisting);
+	}
+	Editor.Commit();
+	return bAllKeyValuePairsAdded;
+}
+
 // Add array of tag key values to the actor,, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(AActor* Actor, const FString& TagType, const TArray<TPair<FString, FString>>& InKeyValuePairs, bool bReplaceExisting)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
 	return FTags::AddKeyValuePairs(Actor->Tags, TagType, InKeyValuePairs, bReplaceExisting, Actor);
 }
 
 // Add array of tag key values to component, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(UActorComponent* Component, const FString& TagType, const TArray<TPair<FString, FString>>& InKeyValuePairs, bool bReplaceExisting)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
 	return FTags::AddKeyValuePairs(Component->ComponentTags, TagType, InKeyValuePairs, bReplaceExisting, Component);
 }
 
 // Add array of tag key values to object, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(UObject* Object, const FString& TagType, const TArray<TPair<FString, FString>>& InKeyValuePairs, bool bReplaceExisting)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
 	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		return FTags::AddKeyValuePairs(ObjAsAct->Tags, TagType, InKeyValuePairs, bReplaceExisting);
+		return FTags::AddKeyValuePairs(ObjAsAct, TagType, InKeyValuePairs, bReplaceExisting);
 	}
 	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
 	{
-		return FTags::AddKeyValuePairs(ObjAsActComp->ComponentTags, TagType, InKeyValuePairs, bReplaceExisting);
+		return FTags::AddKeyValuePairs(ObjAsActComp, TagType, InKeyValuePairs, bReplaceExisting);
 	}
 	return false;
 }
@@ -495,89 +1406,60 @@ bool FTags::AddKeyValuePairs(UObject* Object, const FString& TagType, const TArr
 //Add map of tag key values to tag, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(FName& InTag, const TMap<FString, FString>& InKeyValuePairs, bool bReplaceExisting, UObject* Owner)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
+	// All pairs are applied in memory, the tag is written once
+	FTagEditor Editor(InTag, Owner);
 	bool bAllKeyValuePairsAdded = true;
 	for (const auto& KV : InKeyValuePairs)
 	{
-		// Get the key value
-		const FString CurrVal = FTags::GetValue(InTag, KV.Key);
-		if (CurrVal.IsEmpty())
-		{
-			if (Owner)
-			{
-				Owner->Modify();
-			}
-			// Key does not exist, add new one at the end
-			InTag = FName(*InTag.ToString().Append(KV.Key).Append(",").Append(KV.Value).Append(";"));
-		}
-		else if (bReplaceExisting)
-		{
-			if (Owner)
-			{
-				Owner->Modify();
-			}
-			// Key exist, replace
-			const FString Old = KV.Key + "," + CurrVal;
-			const FString New = KV.Key + "," + KV.Value;
-			InTag = FName(*InTag.ToString().Replace(*Old, *New));
-		}
-		else
-		{
-			// Could not overwrite value
-			bAllKeyValuePairsAdded = false;
-		}
+		// Could not overwrite value
+		bAllKeyValuePairsAdded &= Editor.AddKeyValuePair(0, KV.Key, KV.Value, bReplaceExisting);
 	}
+	Editor.Commit();
 	return bAllKeyValuePairsAdded;
 }
 
 // Add map of tag key values to tags, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(TArray<FName>& InTags, const FString& TagType, const TMap<FString, FString>& InKeyValuePairs, bool bReplaceExisting, UObject* Owner)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex != INDEX_NONE)
-	{
-		return FTags::AddKeyValuePairs(InTags[TagIndex], InKeyValuePairs, bReplaceExisting);
-	}
-	else // Type was not found, create a new one
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
+	// All pairs are applied in memory, the tag is written once (and created if needed)
+	FTagEditor Editor(InTags, Owner);
+	bool bAllKeyValuePairsAdded = true;
+	for (const auto& KV : InKeyValuePairs)
 	{
-		if (Owner)
-		{
-			Owner->Modify();
-		}
-		FString NewTag;
-		NewTag.Append(TagType).Append(";");
-		for (const auto& TagKeyVal : InKeyValuePairs)
-		{
-			NewTag.Append(TagKeyVal.Key).Append(",").Append(TagKeyVal.Value).Append(";");
-		}
-		InTags.Add(FName(*NewTag));
-		return true;
+		// Could not overwrite value
+		bAllKeyValuePairsAdded &= Editor.AddKeyValuePair(TagType, KV.Key, KV.Value, bReplaceExisting);
 	}
-	return false;
+	Editor.Commit();
+	return bAllKeyValuePairsAdded;
 }
 
 // Add map of tag key values to the actor,, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(AActor* Actor, const FString& TagType, const TMap<FString, FString>& InKeyValuePairs, bool bReplaceExisting)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
 	return FTags::AddKeyValuePairs(Actor->Tags, TagType, InKeyValuePairs, bReplaceExisting, Actor);
 }
 
 // Add map of tag key values to component, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(UActorComponent* Component, const FString& TagType, const TMap<FString, FString>& InKeyValuePairs, bool bReplaceExisting)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
 	return FTags::AddKeyValuePairs(Component->ComponentTags, TagType, InKeyValuePairs, bReplaceExisting, Component);
 }
 
 // Add map of tag key values to object, if bReplaceExisting is true, replace existing value
 bool FTags::AddKeyValuePairs(UObject* Object, const FString& TagType, const TMap<FString, FString>& InKeyValuePairs, bool bReplaceExisting)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddKeyValuePairs);
 	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		return FTags::AddKeyValuePairs(ObjAsAct->Tags, TagType, InKeyValuePairs, bReplaceExisting);
+		return FTags::AddKeyValuePairs(ObjAsAct, TagType, InKeyValuePairs, bReplaceExisting);
 	}
 	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
 	{
-		return FTags::AddKeyValuePairs(ObjAsActComp->ComponentTags, TagType, InKeyValuePairs, bReplaceExisting);
+		return FTags::AddKeyValuePairs(ObjAsActComp, TagType, InKeyValuePairs, bReplaceExisting);
 	}
 	return false;
 }
@@ -587,44 +1469,38 @@ bool FTags::AddKeyValuePairs(UObject* Object, const FString& TagType, const TMap
 // Add tag type
 bool FTags::AddTagType(TArray<FName>& InTags, const FString& TagType, UObject* Owner)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex == INDEX_NONE)
-	{
-		if (Owner)
-		{
-			Owner->Modify();
-		}
-		FString NewTag;
-		InTags.Add(FName(*NewTag.Append(TagType).Append(";")));
-		return true;
-	}
-	// Tag already exist
-	return false;
+	UTAGS_SCOPE_CYCLE_COUNTER(AddTagType);
+	FTagEditor Editor(InTags, Owner);
+	const bool bAdded = Editor.AddTagType(TagType);
+	Editor.Commit();
+	return bAdded;
 }
 
 // Add tag type
 bool FTags::AddTagType(AActor* Actor, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddTagType);
 	return FTags::AddTagType(Actor->Tags, TagType, Actor);
 }
 
 // Add tag type
 bool FTags::AddTagType(UActorComponent* Component, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddTagType);
 	return FTags::AddTagType(Component->ComponentTags, TagType, Component);
 }
 
 // Add tag type
 bool FTags::AddTagType(UObject* Object, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(AddTagType);
 	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		return FTags::AddTagType(ObjAsAct->Tags, TagType);
+		return FTags::AddTagType(ObjAsAct, TagType);
 	}
 	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
 	{
-		return FTags::AddTagType(ObjAsActComp->ComponentTags, TagType);
+		return FTags::AddTagType(ObjAsActComp, TagType);
 	}
 	return false;
 }
@@ -634,97 +1510,191 @@ bool FTags::AddTagType(UObject* Object, const FString& TagType)
 // Remove tag key value from tag
 bool FTags::RemoveKeyValuePair(FName& InTag, const FString& TagKey, UObject* Owner)
 {
-	// Copy of the current tag as FString
-	FString CurrTag = InTag.ToString();
-	const FString ToRemove = TagKey + TEXT(",") + GetValue(InTag, TagKey) + TEXT(";");
-	int32 FindPos = CurrTag.Find(ToRemove, ESearchCase::CaseSensitive);
-	if (FindPos != INDEX_NONE)
-	{
-		if (Owner)
-		{
-			Owner->Modify();
-		}
-		CurrTag.RemoveAt(FindPos, ToRemove.Len());
-		InTag = FName(*CurrTag);
-	}
-	// "TagKey,TagValue;" combo could not be found
-	return false;
+	UTAGS_SCOPE_CYCLE_COUNTER(RemoveKeyValuePair);
+	FTagEditor Editor(InTag, Owner);
+	const bool bRemoved = Editor.RemoveKeyValuePair(0, TagKey);
+	Editor.Commit();
+	return bRemoved;
 }
 
 // Remove tag key value from tags
 bool FTags::RemoveKeyValuePair(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, UObject* Owner)
 {
-	// Check if type exists and return index of its location in the array
-	int32 TagIndex = FTags::GetTagTypeIndex(InTags, TagType);
-	if (TagIndex != INDEX_NONE)
+	UTAGS_SCOPE_CYCLE_COUNTER(RemoveKeyValuePair);
+	if (FTagStore* Store = FTagStore::Get())
 	{
-		return FTags::RemoveKeyValuePair(InTags[TagIndex], TagKey, Owner);
+		if (FTagStore::IsOwnerTags(Owner, InTags) && FTags::GetTagTypeIndex(InTags, TagType) != INDEX_NONE)
+		{
+			return Store->RemoveValue(Owner, InTags, TagType, TagKey);
+		}
 	}
+
 	// Tag type not found, nothing to remove
-	return false;
+	FTagEditor Editor(InTags, Owner);
+	const bool bRemoved = Editor.RemoveKeyValuePair(TagType, TagKey);
+	Editor.Commit();
+	return bRemoved;
 }
 
 // Remove tag key value from actor
 bool FTags::RemoveKeyValuePair(AActor* Actor, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(RemoveKeyValuePair);
 	return FTags::RemoveKeyValuePair(Actor->Tags, TagType, TagKey, Actor);
 }
 
 // Remove tag key value from component
 bool FTags::RemoveKeyValuePair(UActorComponent* Component, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(RemoveKeyValuePair);
 	return FTags::RemoveKeyValuePair(Component->ComponentTags, TagType, TagKey, Component);
 }
 
-// Remove all tag key values from world
+// Remove all tag key values from world (actors and components of every loaded level)
 bool FTags::RemoveAllKeyValuePairs(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(RemoveAllKeyValuePairs);
+	// Use the world tag index if enabled, only the objects with the key are changed
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		// Collect first, the removals re-index the objects
+		TArray<UObject*> Objects;
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			Objects.Add(Obj);
+		});
+		for (UObject* Obj : Objects)
+		{
+			if (AActor* Act = Cast<AActor>(Obj))
+			{
+				FTags::RemoveKeyValuePair(Act, TagType, TagKey);
+			}
+			else if (UActorComponent* ActComp = Cast<UActorComponent>(Obj))
+			{
+				FTags::RemoveKeyValuePair(ActComp, TagType, TagKey);
+			}
+		}
+		return true;
+	}
 	// Iterate actors from world
-	//for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	for (const auto& ActorItr : World->PersistentLevel->Actors)
+	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
-		FTags::RemoveKeyValuePair(ActorItr, TagType, TagKey);
+		UTAGS_STAT_OBJECTS_VISITED(1);
+		FTags::RemoveKeyValuePair(*ActorItr, TagType, TagKey);
 
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
 			FTags::RemoveKeyValuePair(CompItr, TagType, TagKey);
 		}
 	}
 	return true;
 }
 
+// Assign unique ids to the key of every actor and component with the tag type
+int32 FTags::AssignUniqueIds(UWorld* World, const FString& TagType, const FString& TagKey, ETagIdPolicy Policy)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(AssignUniqueIds);
+	TArray<UObject*> Objects;
+	GatherWorldObjects(World, true, true, Objects);
+
+	// Read the current ids in parallel, objects without the tag type are skipped
+	struct FIdSlot
+	{
+		bool bHasType = false;
+		bool bNeedsId = false;
+		FString Id;
+	};
+	TArray<FIdSlot> Slots;
+	ParallelParseObjects(Objects, Slots, [&](UObject* Object)
+	{
+		FIdSlot Slot;
+		const TArray<FName>& ObjectTags = GetObjectTags(Object);
+		const int32 TagIndex = FTags::GetTagTypeIndex(ObjectTags, TagType);
+		if (TagIndex != INDEX_NONE)
+		{
+			Slot.bHasType = true;
+			if (Policy == ETagIdPolicy::KeepExisting)
+			{
+				// Ids set at runtime are kept in the tag store (if enabled) until flushed
+				FString StoredId;
+				const FTagStore::EState State = FindStoredValue(Object, TagType, TagKey, StoredId);
+				if (State == FTagStore::EState::Set)
+				{
+					Slot.Id = MoveTemp(StoredId);
+				}
+				else if (State == FTagStore::EState::None)
+				{
+					Slot.Id = FTags::GetValue(ObjectTags[TagIndex], TagKey);
+				}
+			}
+		}
+		return Slot;
+	});
+
+	// Keep the first occurrence of every existing id (in world order), the duplicates (ignoring case) get new ones
+	FConcurrentStringSet UsedIds;
+	TArray<int32> SlotsToAssign;
+	for (int32 Idx = 0; Idx < Slots.Num(); ++Idx)
+	{
+		FIdSlot& Slot = Slots[Idx];
+		if (Slot.bHasType && (Slot.Id.IsEmpty() || !UsedIds.Add(Slot.Id)))
+		{
+			Slot.bNeedsId = true;
+			SlotsToAssign.Add(Idx);
+		}
+	}
+
+	// Generate the new ids in parallel, regenerate on a (case insensitive) collision with any used id
+	ParallelFor(SlotsToAssign.Num(), [&](int32 AssignIdx)
+	{
+		FIdSlot& Slot = Slots[SlotsToAssign[AssignIdx]];
+		do
+		{
+			Slot.Id = FIds::NewGuidInBase64Url();
+		} while (!UsedIds.Add(Slot.Id));
+	});
+
+	// Rewrite all the changed tags in one pass on the calling thread
+	for (const int32 SlotIdx : SlotsToAssign)
+	{
+		UObject* Object = Objects[SlotIdx];
+		if (AActor* ObjAsAct = Cast<AActor>(Object))
+		{
+			FTagEditor Editor(ObjAsAct);
+			Editor.AddKeyValuePair(TagType, TagKey, Slots[SlotIdx].Id, true);
+			Editor.Commit();
+		}
+		else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
+		{
+			FTagEditor Editor(ObjAsActComp);
+			Editor.AddKeyValuePair(TagType, TagKey, Slots[SlotIdx].Id, true);
+			Editor.Commit();
+		}
+	}
+	return SlotsToAssign.Num();
+}
+
 
 ///////////////////////////////////////////////////////////////////////////
 // Get tag key value pairs from tag array
 TMap<FString, FString> FTags::GetKeyValuePairs(const TArray<FName>& InTags, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetKeyValuePairs);
 	// Map of the tag properties
 	TMap<FString, FString> TagProperties;
 
 	// Iterate all the tags, check for keyword TagType
 	for (const auto& TagItr : InTags)
 	{
-		// Copy of the current tag as FString
-		FString CurrTag = TagItr.ToString();
+		// Unchanged tags are parsed only once
+		const FTagParseCache::FTagDataRef TagData = FTagParseCache::Get().GetTagData(TagItr);
 
 		// Check if tag is related to the TagType
-		if (CurrTag.RemoveFromStart(TagType))
+		if (!TagData->TagType.IsEmpty() && TagData->TagType == TagType)
 		{
-			// Split on semicolon
-			FString CurrPair;
-			while (CurrTag.Split(TEXT(";"), &CurrPair, &CurrTag))
-			{
-				// Split on comma
-				FString CurrKey, CurrValue;
-				if (CurrPair.Split(TEXT(","), &CurrKey, &CurrValue))
-				{
-					if (!CurrKey.IsEmpty() && !CurrValue.IsEmpty())
-					{
-						TagProperties.Emplace(CurrKey, CurrValue);
-					}
-				}
-			}
+			TagProperties.Append(TagData->KeyValueMap);
 		}
 	}
 	return TagProperties;
@@ -733,25 +1703,38 @@ TMap<FString, FString> FTags::GetKeyValuePairs(const TArray<FName>& InTags, cons
 // Get tag key value pairs from actor
 TMap<FString, FString> FTags::GetKeyValuePairs(AActor* Actor, const FString& TagType)
 {
-	return FTags::GetKeyValuePairs(Actor->Tags, TagType);
+	UTAGS_SCOPE_CYCLE_COUNTER(GetKeyValuePairs);
+	TMap<FString, FString> TagProperties = FTags::GetKeyValuePairs(Actor->Tags, TagType);
+	if (const FTagStore* Store = FTagStore::Get())
+	{
+		Store->ApplyPending(Actor, TagType, TagProperties);
+	}
+	return TagProperties;
 }
 
 // Get tag key value pairs from component
 TMap<FString, FString> FTags::GetKeyValuePairs(UActorComponent* Component, const FString& TagType)
 {
-	return FTags::GetKeyValuePairs(Component->ComponentTags, TagType);
+	UTAGS_SCOPE_CYCLE_COUNTER(GetKeyValuePairs);
+	TMap<FString, FString> TagProperties = FTags::GetKeyValuePairs(Component->ComponentTags, TagType);
+	if (const FTagStore* Store = FTagStore::Get())
+	{
+		Store->ApplyPending(Component, TagType, TagProperties);
+	}
+	return TagProperties;
 }
 
 // Get tag key value pairs from object
 TMap<FString, FString> FTags::GetKeyValuePairs(UObject* Object, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetKeyValuePairs);
 	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		return FTags::GetKeyValuePairs(ObjAsAct->Tags, TagType);
+		return FTags::GetKeyValuePairs(ObjAsAct, TagType);
 	}
 	else if (UActorComponent* ObjAsActComp = Cast<UActorComponent>(Object))
 	{
-		return FTags::GetKeyValuePairs(ObjAsActComp->ComponentTags, TagType);
+		return FTags::GetKeyValuePairs(ObjAsActComp, TagType);
 	}
 	return TMap<FString, FString>();
 }
@@ -760,13 +1743,25 @@ TMap<FString, FString> FTags::GetKeyValuePairs(UObject* Object, const FString& T
 // Get all objects (actor and actor components) to tag key value pairs from world
 TMap<UObject*, TMap<FString, FString>> FTags::GetObjectKeyValuePairsMap(UWorld* World, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectKeyValuePairsMap);
 	// Map of actors to their tag properties
 	TMap<UObject*, TMap<FString, FString>> ObjectToTagProperties;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithType(TagType, [&](UObject* Obj, const TMap<FString, FString>& KeyValueMap)
+		{
+			ObjectToTagProperties.Emplace(Obj, KeyValueMap);
+		});
+		UTAGS_STAT_RESULT_BYTES(ObjectToTagProperties);
+		return ObjectToTagProperties;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		const TMap<FString, FString> ActorTagProperties =
-			FTags::GetKeyValuePairs(ActorItr->Tags, TagType);
+			FTags::GetKeyValuePairs(*ActorItr, TagType);
 		// If actor has tag type and at least one property
 		if (ActorTagProperties.Num() > 0)
 		{
@@ -776,8 +1771,9 @@ TMap<UObject*, TMap<FString, FString>> FTags::GetObjectKeyValuePairsMap(UWorld*
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
 			const TMap<FString, FString> CompTagProperties =
-				FTags::GetKeyValuePairs(CompItr->ComponentTags, TagType);
+				FTags::GetKeyValuePairs(CompItr, TagType);
 			// If tag type has at least one property
 			if (CompTagProperties.Num() > 0)
 			{
@@ -785,39 +1781,72 @@ TMap<UObject*, TMap<FString, FString>> FTags::GetObjectKeyValuePairsMap(UWorld*
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(ObjectToTagProperties);
 	return ObjectToTagProperties;
 }
 
 // Get all actors to tag key value pairs from world
 TMap<AActor*, TMap<FString, FString>> FTags::GetActorsToKeyValuePairs(UWorld* World, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsToKeyValuePairs);
 	// Map of actors to their tag properties
 	TMap<AActor*, TMap<FString, FString>> ActorToTagProperties;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithType(TagType, [&](UObject* Obj, const TMap<FString, FString>& KeyValueMap)
+		{
+			if (AActor* Act = Cast<AActor>(Obj))
+			{
+				ActorToTagProperties.Emplace(Act, KeyValueMap);
+			}
+		});
+		UTAGS_STAT_RESULT_BYTES(ActorToTagProperties);
+		return ActorToTagProperties;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
-		const TMap<FString, FString> TagProperties = FTags::GetKeyValuePairs(ActorItr->Tags, TagType);
+		UTAGS_STAT_OBJECTS_VISITED(1);
+		const TMap<FString, FString> TagProperties = FTags::GetKeyValuePairs(*ActorItr, TagType);
 		// If actor has tag type and at least one property
 		if (TagProperties.Num() > 0)
 		{
 			ActorToTagProperties.Emplace(*ActorItr, TagProperties);
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(ActorToTagProperties);
 	return ActorToTagProperties;
 }
 
 // Get all components to tag key value pairs from world
 TMap<UActorComponent*, TMap<FString, FString>> FTags::GetComponentsToKeyValuePairs(UWorld* World, const FString& TagType)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsToKeyValuePairs);
 	// Map of actors to their tag properties
 	TMap<UActorComponent*, TMap<FString, FString>> ComponentToTagProperties;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithType(TagType, [&](UObject* Obj, const TMap<FString, FString>& KeyValueMap)
+		{
+			if (UActorComponent* ActComp = Cast<UActorComponent>(Obj))
+			{
+				ComponentToTagProperties.Emplace(ActComp, KeyValueMap);
+			}
+		});
+		UTAGS_STAT_RESULT_BYTES(ComponentToTagProperties);
+		return ComponentToTagProperties;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
-			const TMap<FString, FString> TagProperties = FTags::GetKeyValuePairs(CompItr->ComponentTags, TagType);
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			const TMap<FString, FString> TagProperties = FTags::GetKeyValuePairs(CompItr, TagType);
 			// If tag type has at least one property
 			if (TagProperties.Num() > 0)
 			{
@@ -825,19 +1854,107 @@ TMap<UActorComponent*, TMap<FString, FString>> FTags::GetComponentsToKeyValuePai
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(ComponentToTagProperties);
 	return ComponentToTagProperties;
 }
 
+// Get the objects (actor and actor components) to tag key value pairs of every given tag type, in a single world pass
+TMap<FString, TMap<UObject*, TMap<FString, FString>>> FTags::GetObjectKeyValuePairsMaps(UWorld* World, const TSet<FString>& TagTypes)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectKeyValuePairsMaps);
+	// Tag type -> objects to their tag properties (every requested type has an entry)
+	TMap<FString, TMap<UObject*, TMap<FString, FString>>> TypeToObjectProperties;
+	for (const auto& TagType : TagTypes)
+	{
+		TypeToObjectProperties.Add(TagType);
+	}
+
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		for (auto& TypeItr : TypeToObjectProperties)
+		{
+			Index->ForEachObjectWithType(TypeItr.Key, [&](UObject* Obj, const TMap<FString, FString>& KeyValueMap)
+			{
+				TypeItr.Value.Emplace(Obj, KeyValueMap);
+			});
+		}
+		UTAGS_STAT_RESULT_BYTES(TypeToObjectProperties);
+		return TypeToObjectProperties;
+	}
+
+	// Parse each tag of each object once, dispatch it to its type, then apply the pending values of the tag store (if enabled)
+	const FTagStore* Store = FTagStore::Get();
+	auto AddObjectTags = [&TypeToObjectProperties, Store](UObject* Object, const TArray<FName>& InTags)
+	{
+		for (const auto& TagItr : InTags)
+		{
+			const FTagParseCache::FTagDataRef TagData = FTagParseCache::Get().GetTagData(TagItr);
+			if (TagData->KeyValueMap.Num() > 0)
+			{
+				if (TMap<UObject*, TMap<FString, FString>>* ObjectProperties = TypeToObjectProperties.Find(TagData->TagType))
+				{
+					ObjectProperties->FindOrAdd(Object).Append(TagData->KeyValueMap);
+				}
+			}
+		}
+
+		if (Store && Store->HasPending(Object))
+		{
+			for (auto& TypeItr : TypeToObjectProperties)
+			{
+				if (FTags::GetTagTypeIndex(InTags, TypeItr.Key) != INDEX_NONE)
+				{
+					TMap<FString, FString>& KeyValueMap = TypeItr.Value.FindOrAdd(Object);
+					Store->ApplyPending(Object, TypeItr.Key, KeyValueMap);
+					if (KeyValueMap.Num() == 0)
+					{
+						TypeItr.Value.Remove(Object);
+					}
+				}
+			}
+		}
+	};
+
+	// Iterate all actors
+	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
+		AddObjectTags(*ActorItr, ActorItr->Tags);
+
+		// Iterate components of the actor
+		for (const auto& CompItr : ActorItr->GetComponents())
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			AddObjectTags(CompItr, CompItr->ComponentTags);
+		}
+	}
+	UTAGS_STAT_RESULT_BYTES(TypeToObjectProperties);
+	return TypeToObjectProperties;
+}
+
 
 /////////////////////////////////////////////////////////////////////////
 // Get all objects unique id (actor and actor components) to tag key value
 TMap<uint32, FString> FTags::GetObjectsIdToKeyValue(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsIdToKeyValue);
 	// Map of actors to their tag properties
 	TMap<uint32, FString> ObjectsIdToKeyValue;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			ObjectsIdToKeyValue.Emplace(Obj->GetUniqueID(), Value);
+		});
+		UTAGS_STAT_RESULT_BYTES(ObjectsIdToKeyValue);
+		return ObjectsIdToKeyValue;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Add to map if key is found in the actor
 		FString ActValue = FTags::GetValue(*ActorItr, TagType, TagKey);
 		if (!ActValue.IsEmpty())
@@ -848,6 +1965,7 @@ TMap<uint32, FString> FTags::GetObjectsIdToKeyValue(UWorld* World, const FString
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
 			// Add to map if key is found in the actor
 			FString CompValue = FTags::GetValue(CompItr, TagType, TagKey);
 			if (!CompValue.IsEmpty())
@@ -856,17 +1974,30 @@ TMap<uint32, FString> FTags::GetObjectsIdToKeyValue(UWorld* World, const FString
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(ObjectsIdToKeyValue);
 	return ObjectsIdToKeyValue;
 }
 
 // Get all objects (actor and actor components) to tag key value
 TMap<UObject*, FString> FTags::GetObjectsToKeyValue(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsToKeyValue);
 	// Map of actors to their tag properties
 	TMap<UObject*, FString> ObjectsToKeyValue;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			ObjectsToKeyValue.Emplace(Obj, Value);
+		});
+		UTAGS_STAT_RESULT_BYTES(ObjectsToKeyValue);
+		return ObjectsToKeyValue;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Add to map if key is found in the actor
 		FString ActValue = FTags::GetValue(*ActorItr, TagType, TagKey);
 		if (!ActValue.IsEmpty())
@@ -877,6 +2008,7 @@ TMap<UObject*, FString> FTags::GetObjectsToKeyValue(UWorld* World, const FString
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
 			// Add to map if key is found in the actor
 			FString CompValue = FTags::GetValue(CompItr, TagType, TagKey);
 			if (!CompValue.IsEmpty())
@@ -885,17 +2017,33 @@ TMap<UObject*, FString> FTags::GetObjectsToKeyValue(UWorld* World, const FString
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(ObjectsToKeyValue);
 	return ObjectsToKeyValue;
 }
 
 // Get all actors to tag key value
 TMap<AActor*, FString> FTags::GetActorsToKeyValue(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsToKeyValue);
 	// Map of actors to their tag properties
 	TMap<AActor*, FString> ActorsToKeyValue;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			if (AActor* Act = Cast<AActor>(Obj))
+			{
+				ActorsToKeyValue.Emplace(Act, Value);
+			}
+		});
+		UTAGS_STAT_RESULT_BYTES(ActorsToKeyValue);
+		return ActorsToKeyValue;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Add to map if key is found in the actor
 		FString Value = FTags::GetValue(*ActorItr, TagType, TagKey);
 		if (!Value.IsEmpty())
@@ -903,20 +2051,37 @@ TMap<AActor*, FString> FTags::GetActorsToKeyValue(UWorld* World, const FString&
 			ActorsToKeyValue.Emplace(*ActorItr, Value);
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(ActorsToKeyValue);
 	return ActorsToKeyValue;
 }
 
 // Get all components to tag key value
 TMap<UActorComponent*, FString> FTags::GetComponentsToKeyValue(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsToKeyValue);
 	// Map of actors to their tag properties
 	TMap<UActorComponent*, FString> ComponentsToKeyValue;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			if (UActorComponent* ActComp = Cast<UActorComponent>(Obj))
+			{
+				ComponentsToKeyValue.Emplace(ActComp, Value);
+			}
+		});
+		UTAGS_STAT_RESULT_BYTES(ComponentsToKeyValue);
+		return ComponentsToKeyValue;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
 			// Add to map if key is found in the actor
 			FString Value = FTags::GetValue(CompItr, TagType, TagKey);
 			if (!Value.IsEmpty())
@@ -925,19 +2090,101 @@ TMap<UActorComponent*, FString> FTags::GetComponentsToKeyValue(UWorld* World, co
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(ComponentsToKeyValue);
 	return ComponentsToKeyValue;
 }
 
 
+/////////////////////////////////////////////////////////////////////////
+// Get all objects (actor and actor components) with their tag key value, sorted by object index
+TTagObjectResults<FString> FTags::GetObjectsToKeyValueDense(UWorld* World, const FString& TagType, const FString& TagKey)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsToKeyValueDense);
+	TTagObjectResults<FString> Results = KeyValueDense(World, TagType, TagKey, true, true);
+	UTAGS_STAT_RESULT_BYTES(Results);
+	return Results;
+}
+
+// Get all actors with their tag key value, sorted by object index
+TTagObjectResults<FString> FTags::GetActorsToKeyValueDense(UWorld* World, const FString& TagType, const FString& TagKey)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsToKeyValueDense);
+	TTagObjectResults<FString> Results = KeyValueDense(World, TagType, TagKey, true, false);
+	UTAGS_STAT_RESULT_BYTES(Results);
+	return Results;
+}
+
+// Get all components with their tag key value, sorted by object index
+TTagObjectResults<FString> FTags::GetComponentsToKeyValueDense(UWorld* World, const FString& TagType, const FString& TagKey)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsToKeyValueDense);
+	TTagObjectResults<FString> Results = KeyValueDense(World, TagType, TagKey, false, true);
+	UTAGS_STAT_RESULT_BYTES(Results);
+	return Results;
+}
+
+// Get all objects (actor and actor components) with their tag key value pairs, sorted by object index
+TTagObjectResults<TMap<FString, FString>> FTags::GetObjectKeyValuePairsDense(UWorld* World, const FString& TagType)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectKeyValuePairsDense);
+	TTagObjectResults<TMap<FString, FString>> Results;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithType(TagType, [&](UObject* Obj, const TMap<FString, FString>& KeyValueMap)
+		{
+			Results.Add(Obj, KeyValueMap);
+		});
+	}
+	else
+	{
+		for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			TMap<FString, FString> ActorKeyValuePairs = FTags::GetKeyValuePairs(*ActorItr, TagType);
+			if (ActorKeyValuePairs.Num() > 0)
+			{
+				Results.Add(*ActorItr, MoveTemp(ActorKeyValuePairs));
+			}
+
+			for (const auto& CompItr : ActorItr->GetComponents())
+			{
+				UTAGS_STAT_OBJECTS_VISITED(1);
+				TMap<FString, FString> CompKeyValuePairs = FTags::GetKeyValuePairs(CompItr, TagType);
+				if (CompKeyValuePairs.Num() > 0)
+				{
+					Results.Add(CompItr, MoveTemp(CompKeyValuePairs));
+				}
+			}
+		}
+	}
+	Results.SortByObjectIndex();
+	UTAGS_STAT_RESULT_BYTES(Results);
+	return Results;
+}
+
+
 /////////////////////////////////////////////////////////////////////////
 // Get key values to objects (actor and actor components)
 TMap<FString, UObject*> FTags::GetKeyValuesToObject(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetKeyValuesToObject);
 	// Map of actors to their tag properties
 	TMap<FString, UObject*> KeyValuesToObjects;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			KeyValuesToObjects.Emplace(Value, Obj);
+		});
+		UTAGS_STAT_RESULT_BYTES(KeyValuesToObjects);
+		return KeyValuesToObjects;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Add to map if key is found in the actor
 		FString ActValue = FTags::GetValue(*ActorItr, TagType, TagKey);
 		if (!ActValue.IsEmpty())
@@ -948,6 +2195,7 @@ TMap<FString, UObject*> FTags::GetKeyValuesToObject(UWorld* World, const FString
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
 			// Add to map if key is found in the actor
 			FString CompValue = FTags::GetValue(CompItr, TagType, TagKey);
 			if (!CompValue.IsEmpty())
@@ -956,17 +2204,33 @@ TMap<FString, UObject*> FTags::GetKeyValuesToObject(UWorld* World, const FString
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(KeyValuesToObjects);
 	return KeyValuesToObjects;
 }
 
 // Get tag key values to actors
 TMap<FString, AActor*> FTags::GetKeyValuesToActor(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetKeyValuesToActor);
 	// Map of actors to their tag properties
 	TMap<FString, AActor*> KeyValuesToActor;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			if (AActor* Act = Cast<AActor>(Obj))
+			{
+				KeyValuesToActor.Emplace(Value, Act);
+			}
+		});
+		UTAGS_STAT_RESULT_BYTES(KeyValuesToActor);
+		return KeyValuesToActor;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Add to map if key is found in the actor
 		FString Value = FTags::GetValue(*ActorItr, TagType, TagKey);
 		if (!Value.IsEmpty())
@@ -974,20 +2238,37 @@ TMap<FString, AActor*> FTags::GetKeyValuesToActor(UWorld* World, const FString&
 			KeyValuesToActor.Emplace(Value, *ActorItr);
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(KeyValuesToActor);
 	return KeyValuesToActor;
 }
 
 // Get tag key values to components
 TMap<FString, UActorComponent*> FTags::GetKeyValuesToComponents(UWorld* World, const FString& TagType, const FString& TagKey)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetKeyValuesToComponents);
 	// Map of actors to their tag properties
 	TMap<FString, UActorComponent*> KeyValuesToComponents;
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		Index->ForEachObjectWithKey(TagType, TagKey, [&](UObject* Obj, const FString& Value)
+		{
+			if (UActorComponent* ActComp = Cast<UActorComponent>(Obj))
+			{
+				KeyValuesToComponents.Emplace(Value, ActComp);
+			}
+		});
+		UTAGS_STAT_RESULT_BYTES(KeyValuesToComponents);
+		return KeyValuesToComponents;
+	}
 	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
+			UTAGS_STAT_OBJECTS_VISITED(1);
 			// Add to map if key is found in the actor
 			FString Value = FTags::GetValue(CompItr, TagType, TagKey);
 			if (!Value.IsEmpty())
@@ -996,6 +2277,7 @@ TMap<FString, UActorComponent*> FTags::GetKeyValuesToComponents(UWorld* World, c
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(KeyValuesToComponents);
 	return KeyValuesToComponents;
 }
 
@@ -1004,115 +2286,434 @@ TMap<FString, UActorComponent*> FTags::GetKeyValuesToComponents(UWorld* World, c
 // Get all actors with the key value pair as array
 TArray<AActor*> FTags::GetActorsWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
 {
-	// Array of actors
-	TArray<AActor*> ActorsWithKeyValuePair;
-	// Iterate all actors in the world
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		// Add actor to array if it has tag type with key and value pair
-		if (FTags::HasKeyValuePair(ActorItr->Tags, TagType, TagKey, TagValue))
-		{
-			ActorsWithKeyValuePair.Emplace(*ActorItr);
-		}
-	}
-	return ActorsWithKeyValuePair;
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsWithKeyValuePair);
+	return FTags::GetActorsWithKeyValuePair(World, FTagQuery(TagType, TagKey, TagValue));
 }
 
 // Get all actors with the key value pair as set
 TSet<AActor*> FTags::GetActorsWithKeyValuePairAsSet(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
 {
-	// Set of actors
-	TSet<AActor*> ActorsWithKeyValuePair;
-	// Iterate all actors in the world
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		// Add actor to array if it has tag type with key and value pair
-		if (FTags::HasKeyValuePair(ActorItr->Tags, TagType, TagKey, TagValue))
-		{
-			ActorsWithKeyValuePair.Emplace(*ActorItr);
-		}
-	}
-	return ActorsWithKeyValuePair;
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsWithKeyValuePairAsSet);
+	return FTags::GetActorsWithKeyValuePairAsSet(World, FTagQuery(TagType, TagKey, TagValue));
 }
 
 // Get all components with the key value pair as array
 TArray<UActorComponent*> FTags::GetComponentsWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
 {
-	// Array of components
-	TArray<UActorComponent*> ComponentsWithKeyValuePair;
-	// Iterate all actors in the world
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsWithKeyValuePair);
+	return FTags::GetComponentsWithKeyValuePair(World, FTagQuery(TagType, TagKey, TagValue));
+}
+
+// Get all components with the key value pair as set
+TSet<UActorComponent*> FTags::GetComponentsWithKeyValuePairAsSet(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsWithKeyValuePairAsSet);
+	return FTags::GetComponentsWithKeyValuePairAsSet(World, FTagQuery(TagType, TagKey, TagValue));
+}
+
+
+///////////////////////////////////////////////////////////
+// Get all actors with the key value pair	
+TSet<AActor*> FTags::GetActorSetWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorSetWithKeyValuePair);
+	return TSet<AActor*>(GetActorsWithKeyValuePair(World, TagType, TagKey, TagValue));
+}
+
+// Gets all components with the key value pair
+TSet<UActorComponent*> FTags::GetComponentSetWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentSetWithKeyValuePair);
+	return FTags::GetComponentsWithKeyValuePairAsSet(World, FTagQuery(TagType, TagKey, TagValue));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+// Call the callback with every object (actor and actor components) having the tag type key and its value
+void FTags::ForEachObjectWithTag(UWorld* World, const FString& TagType, const FString& TagKey, TFunctionRef<bool(UObject*, const FTagView&)> Callback)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(ForEachObjectWithTag);
+	// Use the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
 	{
-		// Iterate actor's components
-		for (const auto& CompItr : ActorItr->GetComponents())
+		if (const FTagIndex::ValueToObjectsMap* ValueMap = Index->FindValueMap(TagType, TagKey))
 		{
-			// Add component to container if it has tag type with key and value pair
-			if (FTags::HasKeyValuePair(CompItr->ComponentTags, TagType, TagKey, TagValue))
+			for (const auto& ValueToObjects : *ValueMap)
 			{
-				ComponentsWithKeyValuePair.Emplace(CompItr);
+				for (const auto& ObjPtr : ValueToObjects.Value)
+				{
+					UObject* Obj = ObjPtr.Get();
+					if (Obj && !Callback(Obj, FTagView(ValueToObjects.Key)))
+					{
+						return;
+					}
+				}
 			}
 		}
+		return;
 	}
-	return ComponentsWithKeyValuePair;
-}
 
-// Get all components with the key value pair as set
-TSet<UActorComponent*> FTags::GetComponentsWithKeyValuePairAsSet(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
-{
-	// Set of components
-	TSet<UActorComponent*> ComponentsWithKeyValuePair;
-	// Iterate all actors in the world
+	// Check the first tag of the type, call the callback with a view into the tag (or into the pending value)
+	FString StoredValue;
+	auto VisitObject = [&](UObject* Object, const TArray<FName>& InTags)
+	{
+		for (const auto& TagItr : InTags)
+		{
+			FTagNameBuffer TagBuffer(TagItr);
+			const FTagTokenizer Tokenizer(TagBuffer.GetView());
+			if (Tokenizer.IsType(TagType))
+			{
+				const FTagStore::EState State = FindStoredValue(Object, TagType, TagKey, StoredValue);
+				if (State != FTagStore::EState::None)
+				{
+					return State == FTagStore::EState::Removed || StoredValue.IsEmpty() || Callback(Object, FTagView(StoredValue));
+				}
+
+				FTagView Value;
+				if (Tokenizer.FindValue(TagKey, Value) && !Value.IsEmpty())
+				{
+					return Callback(Object, Value);
+				}
+				return true;
+			}
+		}
+		return true;
+	};
+
+	// Iterate all actors
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
-		// Iterate actor's components
+		UTAGS_STAT_OBJECTS_VISITED(1);
+		if (!VisitObject(*ActorItr, ActorItr->Tags))
+		{
+			return;
+		}
+
+		// Iterate components of the actor
 		for (const auto& CompItr : ActorItr->GetComponents())
 		{
-			// Add component to container if it has tag type with key and value pair
-			if (FTags::HasKeyValuePair(CompItr->ComponentTags, TagType, TagKey, TagValue))
+			UTAGS_STAT_OBJECTS_VISITED(1);
+			if (!VisitObject(CompItr, CompItr->ComponentTags))
 			{
-				ComponentsWithKeyValuePair.Emplace(CompItr);
+				return;
 			}
 		}
 	}
+}
+
+// Call the callback with every object (actor and actor components) having the key value pair
+void FTags::ForEachObjectWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue, TFunctionRef<bool(UObject*)> Callback)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(ForEachObjectWithKeyValuePair);
+	FTags::ForEachObjectWithKeyValuePair(World, FTagQuery(TagType, TagKey, TagValue), Callback);
+}
+
+// Get the first object (actor or actor component) with the key value pair, nullptr if none
+UObject* FTags::FindFirstObjectWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(FindFirstObjectWithKeyValuePair);
+	return FTags::FindFirstObjectWithKeyValuePair(World, FTagQuery(TagType, TagKey, TagValue));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+// Get all objects (actor and actor components) with the value of the tag type key in [Min, Max], in ascending value order
+TArray<UObject*> FTags::GetObjectsWithValueInRange(UWorld* World, const FString& TagType, const FString& TagKey, float Min, float Max)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithValueInRange);
+	// Use the sorted values of the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		return Index->FindObjectsInRange(TagType, TagKey, Min, Max);
+	}
+
+	TArray<TPair<float, UObject*>> Values;
+	GatherNumericValues(World, TagType, TagKey, Values);
+	Values.RemoveAllSwap([Min, Max](const TPair<float, UObject*>& Pair) { return Pair.Key < Min || Pair.Key > Max; });
+	Values.Sort([](const TPair<float, UObject*>& A, const TPair<float, UObject*>& B) { return A.Key < B.Key; });
+
+	TArray<UObject*> Objects;
+	Objects.Reserve(Values.Num());
+	for (const auto& Pair : Values)
+	{
+		Objects.Emplace(Pair.Value);
+	}
+	UTAGS_STAT_RESULT_BYTES(Objects);
+	return Objects;
+}
+
+// Get the (up to) K objects with the largest values of the tag type key, largest first (or the smallest, smallest first)
+TArray<UObject*> FTags::GetObjectsWithTopValues(UWorld* World, const FString& TagType, const FString& TagKey, int32 K, bool bLargest)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithTopValues);
+	// Use the sorted values of the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		return Index->FindTopObjects(TagType, TagKey, K, bLargest);
+	}
+
+	TArray<TPair<float, UObject*>> Values;
+	GatherNumericValues(World, TagType, TagKey, Values);
+	Values.Sort([bLargest](const TPair<float, UObject*>& A, const TPair<float, UObject*>& B) { return bLargest ? A.Key > B.Key : A.Key < B.Key; });
+
+	TArray<UObject*> Objects;
+	for (int32 Idx = 0; Idx < Values.Num() && Idx < K; ++Idx)
+	{
+		Objects.Emplace(Values[Idx].Value);
+	}
+	UTAGS_STAT_RESULT_BYTES(Objects);
+	return Objects;
+}
+
+// Get the (up to) K objects with the values of the tag type key closest to the value, closest first
+TArray<UObject*> FTags::GetObjectsWithNearestValues(UWorld* World, const FString& TagType, const FString& TagKey, float Value, int32 K)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithNearestValues);
+	// Use the sorted values of the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		return Index->FindNearestObjects(TagType, TagKey, Value, K);
+	}
+
+	TArray<TPair<float, UObject*>> Values;
+	GatherNumericValues(World, TagType, TagKey, Values);
+	Values.Sort([Value](const TPair<float, UObject*>& A, const TPair<float, UObject*>& B) { return FMath::Abs(A.Key - Value) < FMath::Abs(B.Key - Value); });
+
+	TArray<UObject*> Objects;
+	for (int32 Idx = 0; Idx < Values.Num() && Idx < K; ++Idx)
+	{
+		Objects.Emplace(Values[Idx].Value);
+	}
+	UTAGS_STAT_RESULT_BYTES(Objects);
+	return Objects;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+// Get all objects (actor and actor components) with the value of the tag type key starting with the prefix
+TArray<UObject*> FTags::GetObjectsWithValuePrefix(UWorld* World, const FString& TagType, const FString& TagKey, const FString& Prefix)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithValuePrefix);
+	// Use the sorted values of the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		return Index->FindObjectsWithValuePrefix(TagType, TagKey, Prefix);
+	}
+	TArray<UObject*> Objects = GatherObjectsWithValue(World, TagType, TagKey, [&Prefix](const FTagView& Value) { return Value.StartsWith(Prefix); });
+	UTAGS_STAT_RESULT_BYTES(Objects);
+	return Objects;
+}
+
+// Get all objects (actor and actor components) with the value of the tag type key ending with the suffix
+TArray<UObject*> FTags::GetObjectsWithValueSuffix(UWorld* World, const FString& TagType, const FString& TagKey, const FString& Suffix)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithValueSuffix);
+	// Use the sorted values of the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		return Index->FindObjectsWithValueSuffix(TagType, TagKey, Suffix);
+	}
+	TArray<UObject*> Objects = GatherObjectsWithValue(World, TagType, TagKey, [&Suffix](const FTagView& Value) { return Value.EndsWith(Suffix); });
+	UTAGS_STAT_RESULT_BYTES(Objects);
+	return Objects;
+}
+
+// Get all objects (actor and actor components) with the value of the tag type key matching the wildcard pattern ('*' and '?')
+TArray<UObject*> FTags::GetObjectsWithValueMatching(UWorld* World, const FString& TagType, const FString& TagKey, const FString& Pattern)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithValueMatching);
+	// Use the sorted values of the world tag index if enabled
+	if (const FTagIndex* Index = FTagIndex::Get(World))
+	{
+		return Index->FindObjectsWithValueMatching(TagType, TagKey, Pattern);
+	}
+	TArray<UObject*> Objects = GatherObjectsWithValue(World, TagType, TagKey, [&Pattern](const FTagView& Value) { return Value.MatchesWildcard(Pattern); });
+	UTAGS_STAT_RESULT_BYTES(Objects);
+	return Objects;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+// Get all actors matching the query as array
+TArray<AActor*> FTags::GetActorsWithKeyValuePair(UWorld* World, const FTagQuery& Query)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsWithKeyValuePair);
+	TArray<AActor*> ActorsWithKeyValuePair;
+	Query.ForEachMatch(World, true, false, [&ActorsWithKeyValuePair](UObject* Obj)
+	{
+		ActorsWithKeyValuePair.Emplace(CastChecked<AActor>(Obj));
+		return true;
+	});
+	UTAGS_STAT_RESULT_BYTES(ActorsWithKeyValuePair);
+	return ActorsWithKeyValuePair;
+}
+
+// Get all actors matching the query as set
+TSet<AActor*> FTags::GetActorsWithKeyValuePairAsSet(UWorld* World, const FTagQuery& Query)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsWithKeyValuePairAsSet);
+	TSet<AActor*> ActorsWithKeyValuePair;
+	Query.ForEachMatch(World, true, false, [&ActorsWithKeyValuePair](UObject* Obj)
+	{
+		ActorsWithKeyValuePair.Emplace(CastChecked<AActor>(Obj));
+		return true;
+	});
+	UTAGS_STAT_RESULT_BYTES(ActorsWithKeyValuePair);
+	return ActorsWithKeyValuePair;
+}
+
+// Get all components matching the query as array
+TArray<UActorComponent*> FTags::GetComponentsWithKeyValuePair(UWorld* World, const FTagQuery& Query)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsWithKeyValuePair);
+	TArray<UActorComponent*> ComponentsWithKeyValuePair;
+	Query.ForEachMatch(World, false, true, [&ComponentsWithKeyValuePair](UObject* Obj)
+	{
+		ComponentsWithKeyValuePair.Emplace(CastChecked<UActorComponent>(Obj));
+		return true;
+	});
+	UTAGS_STAT_RESULT_BYTES(ComponentsWithKeyValuePair);
 	return ComponentsWithKeyValuePair;
 }
 
+// Get all components matching the query as set
+TSet<UActorComponent*> FTags::GetComponentsWithKeyValuePairAsSet(UWorld* World, const FTagQuery& Query)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsWithKeyValuePairAsSet);
+	TSet<UActorComponent*> ComponentsWithKeyValuePair;
+	Query.ForEachMatch(World, false, true, [&ComponentsWithKeyValuePair](UObject* Obj)
+	{
+		ComponentsWithKeyValuePair.Emplace(CastChecked<UActorComponent>(Obj));
+		return true;
+	});
+	UTAGS_STAT_RESULT_BYTES(ComponentsWithKeyValuePair);
+	return ComponentsWithKeyValuePair;
+}
 
-///////////////////////////////////////////////////////////
-// Get all actors with the key value pair	
-TSet<AActor*> FTags::GetActorSetWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
+// Call the callback with every object (actor and actor components) matching the query
+void FTags::ForEachObjectWithKeyValuePair(UWorld* World, const FTagQuery& Query, TFunctionRef<bool(UObject*)> Callback)
 {
-	return TSet<AActor*>(GetActorsWithKeyValuePair(World, TagType, TagKey, TagValue));
+	UTAGS_SCOPE_CYCLE_COUNTER(ForEachObjectWithKeyValuePair);
+	Query.ForEachMatch(World, true, true, Callback);
 }
 
-// Gets all components with the key value pair
-TSet<UActorComponent*> FTags::GetComponentSetWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue)
+// Get the first object (actor or actor component) matching the query, nullptr if none
+UObject* FTags::FindFirstObjectWithKeyValuePair(UWorld* World, const FTagQuery& Query)
 {
-	TSet<UActorComponent*> ComponentsWithTag;
+	UTAGS_SCOPE_CYCLE_COUNTER(FindFirstObjectWithKeyValuePair);
+	UObject* FirstObject = nullptr;
+	Query.ForEachMatch(World, true, true, [&FirstObject](UObject* Object)
+	{
+		FirstObject = Object;
+		return false;
+	});
+	return FirstObject;
+}
 
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+
+///////////////////////////////////////////////////////////////////////////
+// Get all actors matching the query inside the box
+TArray<AActor*> FTags::GetActorsInBox(UWorld* World, const FTagQuery& Query, const FBox& Box)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsInBox);
+	TArray<AActor*> ActorsInBox;
+	// Use the tag spatial index if enabled
+	if (const FTagSpatialIndex* SpatialIndex = FTagSpatialIndex::Get(World))
 	{
-		for (auto& Component : ActorItr->GetComponents())
+		if (SpatialIndex->FindActorsInBox(Query, Box, ActorsInBox))
 		{
-			if (FTags::HasKeyValuePair(Component->ComponentTags, TagType, TagKey, TagValue))
-			{
-				ComponentsWithTag.Add(Component);
-			}
+			UTAGS_STAT_RESULT_BYTES(ActorsInBox);
+			return ActorsInBox;
+		}
+	}
+	Query.ForEachMatch(World, true, false, [&](UObject* Obj)
+	{
+		AActor* Actor = CastChecked<AActor>(Obj);
+		if (Box.IsInsideOrOn(Actor->GetActorLocation()))
+		{
+			ActorsInBox.Emplace(Actor);
+		}
+		return true;
+	});
+	UTAGS_STAT_RESULT_BYTES(ActorsInBox);
+	return ActorsInBox;
+}
+
+// Get all actors matching the query inside the sphere
+TArray<AActor*> FTags::GetActorsInSphere(UWorld* World, const FTagQuery& Query, const FVector& Center, float Radius)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsInSphere);
+	TArray<AActor*> ActorsInSphere;
+	// Use the tag spatial index if enabled
+	if (const FTagSpatialIndex* SpatialIndex = FTagSpatialIndex::Get(World))
+	{
+		if (SpatialIndex->FindActorsInSphere(Query, Center, Radius, ActorsInSphere))
+		{
+			UTAGS_STAT_RESULT_BYTES(ActorsInSphere);
+			return ActorsInSphere;
 		}
 	}
-	return ComponentsWithTag;
+	const float RadiusSquared = FMath::Square(Radius);
+	Query.ForEachMatch(World, true, false, [&](UObject* Obj)
+	{
+		AActor* Actor = CastChecked<AActor>(Obj);
+		if (FVector::DistSquared(Actor->GetActorLocation(), Center) <= RadiusSquared)
+		{
+			ActorsInSphere.Emplace(Actor);
+		}
+		return true;
+	});
+	UTAGS_STAT_RESULT_BYTES(ActorsInSphere);
+	return ActorsInSphere;
 }
 
+// Get the (up to) K actors matching the query closest to the location (within the max distance), closest first
+TArray<AActor*> FTags::GetNearestActors(UWorld* World, const FTagQuery& Query, const FVector& Location, int32 K, float MaxDistance)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetNearestActors);
+	TArray<AActor*> NearestActors;
+	// Use the tag spatial index if enabled
+	if (const FTagSpatialIndex* SpatialIndex = FTagSpatialIndex::Get(World))
+	{
+		if (SpatialIndex->FindNearestActors(Query, Location, K, MaxDistance, NearestActors))
+		{
+			UTAGS_STAT_RESULT_BYTES(NearestActors);
+			return NearestActors;
+		}
+	}
+
+	TArray<TPair<float, AActor*>> Candidates;
+	const float MaxDistanceSquared = FMath::Square(MaxDistance);
+	Query.ForEachMatch(World, true, false, [&](UObject* Obj)
+	{
+		AActor* Actor = CastChecked<AActor>(Obj);
+		const float DistanceSquared = FVector::DistSquared(Actor->GetActorLocation(), Location);
+		if (DistanceSquared <= MaxDistanceSquared)
+		{
+			Candidates.Emplace(DistanceSquared, Actor);
+		}
+		return true;
+	});
+	Candidates.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+	for (int32 Idx = 0; Idx < Candidates.Num() && Idx < K; ++Idx)
+	{
+		NearestActors.Emplace(Candidates[Idx].Value);
+	}
+	UTAGS_STAT_RESULT_BYTES(NearestActors);
+	return NearestActors;
+}
 
 ///////////////////////////////////////////////////////////////////////////
 // Get all the tags from the all the actors in the world which includes the Tags of each actor's components
 TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> FTags::GetWorldTagsData(UWorld * World)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetWorldTagsData);
 	//Declaring our map data type that stores an object reference and all the tag related data in a defined struct
 	TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> WorldTagsData;
 	//Iterate Actors from World
 	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
+		UTAGS_STAT_OBJECTS_VISITED(1);
 		TWeakObjectPtr<AActor> WeakActorPtr = *ActorItr;
 		TArray<FName> ActorTags = WeakActorPtr->Tags;
 		TArray<FTagData> ActorTagsData;
@@ -1127,6 +2728,7 @@ TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> FTags::GetWorldTagsData(UWorld *
 			//Iterate Components Of The Actor
 			for (const auto& CompItr : ActorItr->GetComponents())
 			{
+				UTAGS_STAT_OBJECTS_VISITED(1);
 				TWeakObjectPtr<UActorComponent> WeakComponentPtr = CompItr;
 				TArray<FName> ComponentTags = CompItr->ComponentTags;
 				TArray<FTagData> ComponentTagsData;
@@ -1141,29 +2743,152 @@ TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> FTags::GetWorldTagsData(UWorld *
 			}
 		}
 	}
+	UTAGS_STAT_RESULT_BYTES(WorldTagsData);
 	return WorldTagsData;
 }
 
 // Get all the Tags Data (TagType and Key/Values) from a given Object
-TArray<FTagData> FTags::GetObjectTagsData(TArray<FName>& InTags, UObject* ObjectOfActorOrComponent)
+TArray<FTagData> FTags::GetObjectTagsData(const TArray<FName>& InTags, UObject* ObjectOfActorOrComponent)
 {
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectTagsData);
+	// Parse every tag exactly once
+	TArray<FTagParseCache::FTagDataRef, TInlineAllocator<8>> ParsedTags;
+	TMap<FString, TMap<FString, FString>> TypeToKeyValuePairs;
+	for (const FName& Tag : InTags)
+	{
+		if (!Tag.IsNone())
+		{
+			const FTagParseCache::FTagDataRef& TagData = ParsedTags.Add_GetRef(FTagParseCache::Get().GetTagData(Tag));
+			// Tags of the same type share their merged key value pairs (same as GetKeyValuePairs of the type)
+			TypeToKeyValuePairs.FindOrAdd(TagData->TagType).Append(TagData->KeyValueMap);
+		}
+	}
+
 	TArray<FTagData> ObjectsTagsData;
+	ObjectsTagsData.Reserve(ParsedTags.Num());
+	for (const auto& TagData : ParsedTags)
+	{
+		FTagData& IndividualTagData = ObjectsTagsData.AddDefaulted_GetRef();
+		IndividualTagData.TagType = TagData->TagType;
+		IndividualTagData.KeyValueMap = TypeToKeyValuePairs.FindChecked(TagData->TagType);
+	}
 
-	for (FName Tag : InTags)
+	// Values set at runtime are kept in the tag store (if enabled) until flushed
+	const FTagStore* Store = FTagStore::Get();
+	if (ObjectOfActorOrComponent && Store && Store->HasPending(ObjectOfActorOrComponent))
 	{
-		FString TagString = Tag.ToString();
-		if (!TagString.IsEmpty())
-		{
-			FString TagType, KeyValuePairs;
-			TagString.Split(TEXT(";"), &TagType, &KeyValuePairs);
+		Store->ApplyPending(ObjectOfActorOrComponent, ObjectsTagsData);
+	}
+	return ObjectsTagsData;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+// Get all objects (actor and actor components) to tag key value pairs from world, parsed in parallel
+TMap<UObject*, TMap<FString, FString>> FTags::GetObjectKeyValuePairsMapParallel(UWorld* World, const FString& TagType)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectKeyValuePairsMapParallel);
+	// The world tag index (if enabled) is already faster than a parallel scan
+	if (FTagIndex::Get(World))
+	{
+		return FTags::GetObjectKeyValuePairsMap(World, TagType);
+	}
+	return ParallelKeyValuePairs<UObject>(World, TagType, true, true);
+}
+
+// Get all actors to tag key value pairs from world, parsed in parallel
+TMap<AActor*, TMap<FString, FString>> FTags::GetActorsToKeyValuePairsParallel(UWorld* World, const FString& TagType)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetActorsToKeyValuePairsParallel);
+	// The world tag index (if enabled) is already faster than a parallel scan
+	if (FTagIndex::Get(World))
+	{
+		return FTags::GetActorsToKeyValuePairs(World, TagType);
+	}
+	return ParallelKeyValuePairs<AActor>(World, TagType, true, false);
+}
+
+// Get all components to tag key value pairs from world, parsed in parallel
+TMap<UActorComponent*, TMap<FString, FString>> FTags::GetComponentsToKeyValuePairsParallel(UWorld* World, const FString& TagType)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetComponentsToKeyValuePairsParallel);
+	// The world tag index (if enabled) is already faster than a parallel scan
+	if (FTagIndex::Get(World))
+	{
+		return FTags::GetComponentsToKeyValuePairs(World, TagType);
+	}
+	return ParallelKeyValuePairs<UActorComponent>(World, TagType, false, true);
+}
 
-			FTagData IndividualTagData;
-			IndividualTagData.TagType = TagType;
-			IndividualTagData.KeyValueMap = FTags::GetKeyValuePairs(ObjectOfActorOrComponent, TagType);
+// Get all the tags data of the actors and their components from the world, parsed in parallel
+TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> FTags::GetWorldTagsDataParallel(UWorld* World)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetWorldTagsDataParallel);
+	TArray<UObject*> Objects;
+	GatherWorldObjects(World, true, true, Objects);
+
+	// Same as the serial version, only objects with allocated tag arrays are added
+	TArray<TOptional<TArray<FTagData>>> Results;
+	ParallelParseObjects(Objects, Results, [](UObject* Object)
+	{
+		const TArray<FName>& ObjectTags = GetObjectTags(Object);
+		return ObjectTags.GetData() != nullptr
+			? TOptional<TArray<FTagData>>(FTags::GetObjectTagsData(ObjectTags, Object))
+			: TOptional<TArray<FTagData>>();
+	});
 
-			ObjectsTagsData.Add(IndividualTagData);
+	TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> WorldTagsData;
+	for (int32 Idx = 0; Idx < Objects.Num(); ++Idx)
+	{
+		if (Results[Idx].IsSet())
+		{
+			WorldTagsData.Add(Objects[Idx], MoveTemp(Results[Idx].GetValue()));
 		}
 	}
-	return ObjectsTagsData;
+	UTAGS_STAT_RESULT_BYTES(WorldTagsData);
+	return WorldTagsData;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+// Get all objects (actor and actor components) to tag key value, parsed on the task graph
+TFuture<TMap<TWeakObjectPtr<UObject>, FString>> FTags::GetObjectsToKeyValueAsync(UWorld* World, const FString& TagType, const FString& TagKey)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsToKeyValueAsync);
+	return AsyncQueryFuture<TMap<TWeakObjectPtr<UObject>, FString>>(World, true, true, MakeObjectsToKeyValueQuery(TagType, TagKey));
+}
+
+// Get all objects (actor and actor components) to tag key value, parsed on the task graph, the callback is called on the game thread
+void FTags::GetObjectsToKeyValueAsync(UWorld* World, const FString& TagType, const FString& TagKey, TFunction<void(const TMap<TWeakObjectPtr<UObject>, FString>&)> OnComplete)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsToKeyValueAsync);
+	AsyncQueryCallback<TMap<TWeakObjectPtr<UObject>, FString>>(World, true, true, MakeObjectsToKeyValueQuery(TagType, TagKey), OnComplete);
+}
+
+// Get all objects (actor and actor components) to tag key value pairs, parsed on the task graph
+TFuture<TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>> FTags::GetObjectKeyValuePairsMapAsync(UWorld* World, const FString& TagType)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectKeyValuePairsMapAsync);
+	return AsyncQueryFuture<TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>>(World, true, true, MakeObjectKeyValuePairsMapQuery(TagType));
+}
 
-}
\ No newline at end of file
+// Get all objects (actor and actor components) to tag key value pairs, parsed on the task graph, the callback is called on the game thread
+void FTags::GetObjectKeyValuePairsMapAsync(UWorld* World, const FString& TagType, TFunction<void(const TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>&)> OnComplete)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectKeyValuePairsMapAsync);
+	AsyncQueryCallback<TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>>(World, true, true, MakeObjectKeyValuePairsMapQuery(TagType), OnComplete);
+}
+
+// Get all objects (actor and actor components) matching the query, evaluated on the task graph
+TFuture<TArray<TWeakObjectPtr<UObject>>> FTags::GetObjectsWithKeyValuePairAsync(UWorld* World, const FTagQuery& Query)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithKeyValuePairAsync);
+	return AsyncQueryFuture<TArray<TWeakObjectPtr<UObject>>>(World, true, true, MakeObjectsWithQuery(Query));
+}
+
+// Get all objects (actor and actor components) matching the query, evaluated on the task graph, the callback is called on the game thread
+void FTags::GetObjectsWithKeyValuePairAsync(UWorld* World, const FTagQuery& Query, TFunction<void(const TArray<TWeakObjectPtr<UObject>>&)> OnComplete)
+{
+	UTAGS_SCOPE_CYCLE_COUNTER(GetObjectsWithKeyValuePairAsync);
+	AsyncQueryCallback<TArray<TWeakObjectPtr<UObject>>>(World, true, true, MakeObjectsWithQuery(Query), OnComplete);
+}
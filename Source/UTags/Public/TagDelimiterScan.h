@@ -0,0 +1,118 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "TagTokenizer.h"
+
+/**
+* Finds every ';' and ',' of a tag in one pass, with SSE2 on x86/x64
+* (8 UTF-16 characters per compare) and a scalar loop elsewhere and for the tail
+*/
+struct UTAGS_API FTagDelimiterScan
+{
+	// Offsets of the delimiters, in order (most tags fit inline)
+	typedef TArray<int32, TInlineAllocator<64>> FOffsets;
+
+	// Append the offsets of the delimiters of the text
+	static void Scan(const FTagView& InText, FOffsets& OutOffsets);
+
+	// Append the offsets of the delimiters in [Start, End) character by character
+	static void ScanScalar(const TCHAR* Data, int32 Start, int32 End, FOffsets& OutOffsets);
+
+	// Check if the vectorized scan is compiled in for the TCHAR size of the platform
+	static bool IsVectorized();
+};
+
+
+/**
+* Splits a whole tag with a precomputed delimiter table,
+* same results as FTagTokenizer::Next, without rescanning the characters
+*
+* Used when all pairs are needed (FTagTokenizer stops at the first match, it is better for single key lookups)
+*/
+class FTagSplitter
+{
+public:
+	// Scan the delimiters of the tag and split its type
+	explicit FTagSplitter(const FTagView& InTag) : Tag(InTag), Pos(InTag.Len), OffsetIdx(0), bHasType(false)
+	{
+		FTagDelimiterScan::Scan(InTag, Offsets);
+		for (int32 Idx = 0; Idx < Offsets.Num(); ++Idx)
+		{
+			if (Tag.Data[Offsets[Idx]] == TEXT(';'))
+			{
+				Type = FTagView(Tag.Data, Offsets[Idx]);
+				Pos = Offsets[Idx] + 1;
+				OffsetIdx = Idx + 1;
+				bHasType = true;
+				break;
+			}
+		}
+	}
+
+	// Check if the tag has a type (it contains the type separator)
+	FORCEINLINE bool HasType() const
+	{
+		return bHasType;
+	}
+
+	// Get the tag type
+	FORCEINLINE const FTagView& GetType() const
+	{
+		return Type;
+	}
+
+	// Move to the next key value pair (segments without a comma are skipped), false if no pairs left
+	bool Next(FTagView& OutKey, FTagView& OutValue)
+	{
+		while (Pos < Tag.Len)
+		{
+			// The segment ends at the next semicolon, it is split on its first comma
+			int32 End = Tag.Len;
+			int32 Comma = INDEX_NONE;
+			while (OffsetIdx < Offsets.Num())
+			{
+				const int32 Offset = Offsets[OffsetIdx++];
+				if (Tag.Data[Offset] == TEXT(';'))
+				{
+					End = Offset;
+					break;
+				}
+				else if (Comma == INDEX_NONE)
+				{
+					Comma = Offset;
+				}
+			}
+
+			const int32 Start = Pos;
+			Pos = End + 1;
+			if (Comma != INDEX_NONE)
+			{
+				OutKey = FTagView(Tag.Data + Start, Comma - Start);
+				OutValue = FTagView(Tag.Data + Comma + 1, End - Comma - 1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	// The split tag
+	FTagView Tag;
+
+	// The tag type
+	FTagView Type;
+
+	// Delimiter offsets of the tag
+	FTagDelimiterScan::FOffsets Offsets;
+
+	// Start of the next segment
+	int32 Pos;
+
+	// Next unvisited delimiter
+	int32 OffsetIdx;
+
+	// True if the tag contains the type separator
+	bool bHasType;
+};
@@ -0,0 +1,109 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Tags.h"
+#include "TagTokenizer.h"
+
+/**
+* Transactional editor of the tags of an actor or component (or of a single tag)
+*
+* The tags are parsed once (lazily, per tag), any number of add/replace/remove
+* operations are applied in memory, Commit() writes exactly one new FName per
+* changed tag and calls Modify() on the owner once
+*/
+class UTAGS_API FTagEditor
+{
+public:
+	// Edit a tags array, the owner (if any) is modified and notified on commit
+	FTagEditor(TArray<FName>& InTags, UObject* InOwner = nullptr);
+
+	// Edit a single tag, the operations apply to the type of the tag
+	FTagEditor(FName& InTag, UObject* InOwner = nullptr);
+
+	// Edit the tags of the actor
+	explicit FTagEditor(AActor* Actor);
+
+	// Edit the tags of the component
+	explicit FTagEditor(UActorComponent* Component);
+
+	// Return the index of the first tag of the given type, INDEX_NONE if not found
+	int32 FindTagType(const FString& TagType) const;
+
+	// Add a new tag of the given type, false if the type already exists
+	bool AddTagType(const FString& TagType);
+
+	// Add key value pair to the tag type (the tag is created if needed), if bReplaceExisting is true, replace existing value
+	bool AddKeyValuePair(const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting = true);
+
+	// Add key value pair to the tag at the given index, if bReplaceExisting is true, replace existing value
+	// (an unchanged value is not copied, a changed one reuses the allocation of the old value)
+	bool AddKeyValuePair(int32 TagIndex, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting = true);
+
+	// Remove key value pair from the tag type
+	bool RemoveKeyValuePair(const FString& TagType, const FString& TagKey);
+
+	// Remove key value pair from the tag at the given index
+	bool RemoveKeyValuePair(int32 TagIndex, const FString& TagKey);
+
+	// Get the (edited) value of the key of the tag type, empty if not found
+	FString GetValue(const FString& TagType, const FString& TagKey) const;
+
+	// Check if there are uncommitted changes
+	bool HasChanges() const;
+
+	// Write the changed tags, returns the number of written tags
+	int32 Commit();
+
+	// Drop the uncommitted changes
+	void Discard();
+
+private:
+	// A key value pair (or a malformed segment without a value, kept as is)
+	struct FPair
+	{
+		FString Key;
+		FString Value;
+		bool bHasValue;
+	};
+
+	// Edited state of a tag
+	struct FEntry
+	{
+		FString TagType;
+		TArray<FPair> Pairs;
+		bool bParsed = false;
+		bool bHasType = false;
+		bool bDirty = false;
+		bool bNew = false;
+	};
+
+	// Write the pending tag store values of the owner to its tags
+	void FlushStore();
+
+	// Number of tags in the edited source
+	int32 NumSourceTags() const;
+
+	// Get the source tag at the given index
+	const FName& GetSourceTag(int32 TagIndex) const;
+
+	// Parse the tag on its first edit
+	FEntry& GetParsedEntry(int32 TagIndex);
+
+	// Build the tag string of the entry
+	static FString ToTagString(const FEntry& Entry);
+
+private:
+	// The edited tags array (nullptr in single tag mode)
+	TArray<FName>* Tags;
+
+	// The edited tag (nullptr in array mode)
+	FName* SingleTag;
+
+	// Owner of the tags, modified and notified on commit
+	UObject* Owner;
+
+	// One entry per source tag, followed by the new tags
+	TArray<FEntry> Entries;
+};
@@ -0,0 +1,318 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Tags.h"
+#include "TagStats.h"
+#include "TagTokenizer.h"
+#include "Algo/BinarySearch.h"
+
+/**
+* Opt-in tag index of a world, built once and kept up to date from
+* actor spawn/destroy events, level streaming and the FTags mutators
+*
+* Maps (TagType, Key, Value) to objects and (TagType, Key) to values,
+* the FTags world queries use it (if enabled) instead of iterating the world
+*
+* Same as the FTags functions, the key value entries follow the first tag of each type
+* (FTags::GetValue, HasKeyValuePair), while the key value pairs of an object merge all
+* its tags of the type (FTags::GetKeyValuePairs)
+*
+* Numeric keys get a sorted value index on their first range query, and
+* keys get a sorted list of their distinct values on their first prefix,
+* suffix or wildcard query; both are then kept sorted by the same updates
+*
+* The indexed objects are partitioned by level, a streamed in level only
+* indexes its own actors and a streamed out level only drops its own objects
+*/
+class UTAGS_API FTagIndex
+{
+public:
+	// Objects (actors and actor components) sharing the same tag value
+	typedef TArray<TWeakObjectPtr<UObject>> ObjectArray;
+	typedef TMap<FString, ObjectArray> ValueToObjectsMap;
+
+	// Value of an identity key shared by more than one object
+	struct FDuplicateValue
+	{
+		FString TagType;
+		FString TagKey;
+		FString Value;
+		ObjectArray Objects;
+	};
+
+	// Create and build the index of the world (returns the existing one if already enabled)
+	static FTagIndex* Enable(UWorld* World);
+
+	// Remove the index of the world
+	static void Disable(UWorld* World);
+
+	// Get the index of the world, nullptr if it is not enabled
+	static FTagIndex* Get(UWorld* World);
+
+	// Unregister from the world and engine events
+	~FTagIndex();
+
+	// Clear and re-index all the actors and components of the world
+	void Rebuild();
+
+	// (Re)index the tags of the actor and of its components, or of the component
+	void AddObject(UObject* Object);
+
+	// Remove the actor and its components, or the component, from the index
+	void RemoveObject(UObject* Object);
+
+	// Remove the destroyed objects (done after every garbage collection), returns the number of removed objects
+	int32 Compact();
+
+	// Index the actors and components of the level (done when the level is added to the world)
+	void AddLevel(ULevel* Level);
+
+	// Remove the objects of the level partition (done when the level is removed from the world)
+	void RemoveLevel(ULevel* Level);
+
+	// Number of indexed levels
+	int32 NumLevels() const { return LevelObjects.Num(); }
+
+	// Number of indexed objects of the level
+	int32 NumLevelObjects(ULevel* Level) const;
+
+	// Number of indexed objects
+	int32 Num() const { return ObjectTags.Num(); }
+
+	// Get the indexed tags data of the object, nullptr if the object has no indexed tags
+	const TArray<FTagData>* FindObjectTags(UObject* Object) const;
+
+	// Get the value to objects map of the tag type key, nullptr if the key is not indexed
+	const ValueToObjectsMap* FindValueMap(const FString& TagType, const FString& TagKey) const;
+
+	// Get the objects with the tag type key value pair, nullptr if none is indexed
+	const ObjectArray* FindObjects(const FString& TagType, const FString& TagKey, const FString& TagValue) const;
+
+	// Mark the tag type key as an identity key (its values are expected to be unique), duplicates are tracked from now on
+	void AddIdentityKey(const FString& TagType, const FString& TagKey);
+
+	// Stop tracking the duplicates of the identity key
+	void RemoveIdentityKey(const FString& TagType, const FString& TagKey);
+
+	// Check if the tag type key is an identity key
+	bool IsIdentityKey(const FString& TagType, const FString& TagKey) const;
+
+	// Get the object with the identity key value, nullptr if none or if the value is shared by more than one object
+	UObject* FindObjectById(const FString& TagType, const FString& TagKey, const FString& TagValue) const;
+
+	// Get the identity key values shared by more than one valid object
+	TArray<FDuplicateValue> GetDuplicates() const;
+
+	// Check if any identity key value is shared by more than one valid object
+	bool HasDuplicates() const;
+
+	// Get the objects with the numeric value of the tag type key in [Min, Max], in ascending value order
+	TArray<UObject*> FindObjectsInRange(const FString& TagType, const FString& TagKey, float Min, float Max) const;
+
+	// Get the (up to) K objects with the largest values of the tag type key, largest first (or the smallest, smallest first)
+	TArray<UObject*> FindTopObjects(const FString& TagType, const FString& TagKey, int32 K, bool bLargest = true) const;
+
+	// Get the (up to) K objects with the values of the tag type key closest to the value, closest first
+	TArray<UObject*> FindNearestObjects(const FString& TagType, const FString& TagKey, float Value, int32 K = 1) const;
+
+	// Drop the sorted value index of the tag type key (it is built again on the next range query)
+	void RemoveNumericIndex(const FString& TagType, const FString& TagKey);
+
+	// Get the objects with the value of the tag type key starting with the prefix (ignoring case), grouped by value in ascending order
+	TArray<UObject*> FindObjectsWithValuePrefix(const FString& TagType, const FString& TagKey, const FString& Prefix) const;
+
+	// Get the objects with the value of the tag type key ending with the suffix (ignoring case)
+	TArray<UObject*> FindObjectsWithValueSuffix(const FString& TagType, const FString& TagKey, const FString& Suffix) const;
+
+	// Get the objects with the value of the tag type key matching the wildcard pattern ('*' and '?', ignoring case)
+	TArray<UObject*> FindObjectsWithValueMatching(const FString& TagType, const FString& TagKey, const FString& Pattern) const;
+
+	// Drop the sorted distinct values of the tag type key (they are sorted again on the next prefix, suffix or wildcard query)
+	void RemoveValueIndex(const FString& TagType, const FString& TagKey);
+
+	// Call the functor with every valid object having the tag type (with at least one key value pair) and its key value pairs
+	template<typename FunctorType>
+	void ForEachObjectWithType(const FString& TagType, FunctorType&& Functor) const
+	{
+		if (const ObjectArray* Objects = TypeToObjects.Find(TagType))
+		{
+			for (const auto& ObjPtr : *Objects)
+			{
+				if (UObject* Obj = ObjPtr.Get())
+				{
+					UTAGS_STAT_OBJECTS_VISITED(1);
+					const FTagData* TagData = FindObjectTagData(ObjPtr, TagType);
+					if (TagData && TagData->KeyValueMap.Num() > 0)
+					{
+						Functor(Obj, TagData->KeyValueMap);
+					}
+				}
+			}
+		}
+	}
+
+	// Call the functor with every valid object having the tag type key and its value
+	template<typename FunctorType>
+	void ForEachObjectWithKey(const FString& TagType, const FString& TagKey, FunctorType&& Functor) const
+	{
+		if (const ValueToObjectsMap* ValueMap = FindValueMap(TagType, TagKey))
+		{
+			for (const auto& ValueToObjects : *ValueMap)
+			{
+				for (const auto& ObjPtr : ValueToObjects.Value)
+				{
+					if (UObject* Obj = ObjPtr.Get())
+					{
+						UTAGS_STAT_OBJECTS_VISITED(1);
+						Functor(Obj, ValueToObjects.Key);
+					}
+				}
+			}
+		}
+	}
+
+	// Call the functor with every valid object having the tag type key value pair
+	template<typename FunctorType>
+	void ForEachObjectWithKeyValuePair(const FString& TagType, const FString& TagKey, const FString& TagValue, FunctorType&& Functor) const
+	{
+		if (const ObjectArray* Objects = FindObjects(TagType, TagKey, TagValue))
+		{
+			for (const auto& ObjPtr : *Objects)
+			{
+				if (UObject* Obj = ObjPtr.Get())
+				{
+					UTAGS_STAT_OBJECTS_VISITED(1);
+					Functor(Obj);
+				}
+			}
+		}
+	}
+
+private:
+	// Numeric value of an object
+	struct FNumericEntry
+	{
+		float Value;
+		TWeakObjectPtr<UObject> Object;
+	};
+	typedef TArray<FNumericEntry> NumericArray;
+
+	// Distinct values of a key sorted ignoring case, the reversed values are only sorted for suffix queries
+	struct FSortedValues
+	{
+		TArray<FString> Values;
+		TArray<FString> ReversedValues;
+		bool bHasReversed = false;
+	};
+
+	// Use Enable() to create the index
+	FTagIndex(UWorld* InWorld);
+
+	// Index the tags of a single object
+	void AddSingleObject(UObject* Object, const TArray<FName>& InTags);
+
+	// Remove a single object from the index
+	void RemoveSingleObject(const TWeakObjectPtr<UObject>& ObjPtr);
+
+	// Remove the objects of the level partition (the level might already be destroyed)
+	void RemoveLevelPartition(const TWeakObjectPtr<ULevel>& LevelPtr);
+
+	// Get the level of the actor or of the component owner
+	static ULevel* GetObjectLevel(UObject* Object);
+
+	// Get the tracked duplicate values of the identity key, nullptr if it is not an identity key
+	TSet<FString>* FindIdentityDuplicates(const FString& TagType, const FString& TagKey);
+
+	// Number of valid objects in the array
+	static int32 NumValid(const ObjectArray& Objects);
+
+	// Get the sorted values of the tag type key, built from the indexed values on first use
+	const NumericArray& GetNumericIndex(const FString& TagType, const FString& TagKey) const;
+
+	// Insert the value of the object into the sorted values of the key (if built and the value is numeric)
+	void AddNumericValue(const FString& TagType, const FString& TagKey, const FString& TagValue, const TWeakObjectPtr<UObject>& ObjPtr);
+
+	// Remove the value of the object from the sorted values of the key (if built)
+	void RemoveNumericValue(const FString& TagType, const FString& TagKey, const FString& TagValue, const TWeakObjectPtr<UObject>& ObjPtr);
+
+	// Index of the first value not less than the given one
+	static int32 LowerBoundValue(const NumericArray& Values, float Value);
+
+	// Get the sorted distinct values of the tag type key, built from the indexed values on first use
+	const FSortedValues& GetSortedValues(const FString& TagType, const FString& TagKey, bool bWithReversed) const;
+
+	// Insert or remove a distinct value of the key in its sorted values (if built)
+	void AddSortedValue(const FString& TagType, const FString& TagKey, const FString& TagValue);
+	void RemoveSortedValue(const FString& TagType, const FString& TagKey, const FString& TagValue);
+
+	// Call the functor with every sorted string starting with the prefix
+	template<typename FunctorType>
+	static void ForEachWithPrefix(const TArray<FString>& Sorted, const FString& Prefix, FunctorType&& Functor)
+	{
+		for (int32 Idx = Algo::LowerBound(Sorted, Prefix); Idx < Sorted.Num() && FTagView(Sorted[Idx]).StartsWith(Prefix); ++Idx)
+		{
+			Functor(Sorted[Idx]);
+		}
+	}
+
+	// Append the valid objects of the value of the key
+	static void AppendValueObjects(const ValueToObjectsMap& ValueMap, const FString& TagValue, TArray<UObject*>& OutObjects);
+
+	// Get the indexed tag data of the given type of the object
+	const FTagData* FindObjectTagData(const TWeakObjectPtr<UObject>& ObjPtr, const FString& TagType) const;
+
+	// Callbacks
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnPostGarbageCollect();
+	void OnTagsChanged(UObject* Owner);
+	void OnLevelAdded(ULevel* InLevel, UWorld* InWorld);
+	void OnLevelRemoved(ULevel* InLevel, UWorld* InWorld);
+	static void OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
+
+	// Access to the enabled world indices
+	static TMap<TWeakObjectPtr<UWorld>, TUniquePtr<FTagIndex>>& GetWorldIndices();
+
+private:
+	// The indexed world
+	TWeakObjectPtr<UWorld> World;
+
+	// TagType -> Key -> Value -> Objects
+	TMap<FString, TMap<FString, ValueToObjectsMap>> Entries;
+
+	// TagType -> Objects
+	TMap<FString, ObjectArray> TypeToObjects;
+
+	// Level -> indexed objects of the level
+	TMap<TWeakObjectPtr<ULevel>, TSet<TWeakObjectPtr<UObject>>> LevelObjects;
+
+	// Object -> level partition of the object
+	TMap<TWeakObjectPtr<UObject>, TWeakObjectPtr<ULevel>> ObjectLevels;
+
+	// Identity TagType -> Key -> values with more than one object (possibly stale, validated when reported)
+	TMap<FString, TMap<FString, TSet<FString>>> IdentityKeys;
+
+	// TagType -> Key -> values in ascending order (only for the keys with range queries)
+	mutable TMap<FString, TMap<FString, NumericArray>> NumericIndices;
+
+	// TagType -> Key -> sorted distinct values (only for the keys with prefix, suffix or wildcard queries)
+	mutable TMap<FString, TMap<FString, FSortedValues>> SortedValueIndices;
+
+	// Object -> indexed tags data (one entry per tag type)
+	TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> ObjectTags;
+
+	// Object -> first tag of each type, only for the objects with more than one tag of a type
+	TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> FirstTagsOfType;
+
+	// Event handles
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle TagsChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -0,0 +1,115 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+/**
+* Dense world query results in structure of arrays form: the object indices
+* (UObject::GetUniqueID, the internal object array index), the objects and
+* their values are stored in parallel arrays, sorted by the object index
+*
+* Lookups are binary searches, iteration is contiguous; the hashed TMap
+* results of the FTags functions are kept for compatibility
+*/
+template<typename ValueType>
+struct TTagObjectResults
+{
+	// Sorted internal object indices
+	TArray<uint32> ObjectIndices;
+
+	// Objects, in the same order
+	TArray<TWeakObjectPtr<UObject>> Objects;
+
+	// Values, in the same order
+	TArray<ValueType> Values;
+
+	// Number of results
+	FORCEINLINE int32 Num() const
+	{
+		return ObjectIndices.Num();
+	}
+
+	// Reserve space for the given number of results
+	void Reserve(int32 Number)
+	{
+		ObjectIndices.Reserve(Number);
+		Objects.Reserve(Number);
+		Values.Reserve(Number);
+	}
+
+	// Append a result, call SortByObjectIndex() after the last one
+	template<typename ArgType>
+	void Add(UObject* Object, ArgType&& Value)
+	{
+		ObjectIndices.Add(Object->GetUniqueID());
+		Objects.Emplace(Object);
+		Values.Emplace(Forward<ArgType>(Value));
+	}
+
+	// Sort the parallel arrays by the object index (nothing is moved if already sorted)
+	void SortByObjectIndex()
+	{
+		bool bSorted = true;
+		for (int32 Idx = 1; Idx < ObjectIndices.Num() && bSorted; ++Idx)
+		{
+			bSorted = ObjectIndices[Idx - 1] <= ObjectIndices[Idx];
+		}
+		if (bSorted)
+		{
+			return;
+		}
+
+		TArray<int32> Order;
+		Order.SetNumUninitialized(Num());
+		for (int32 Idx = 0; Idx < Order.Num(); ++Idx)
+		{
+			Order[Idx] = Idx;
+		}
+		Order.Sort([this](int32 A, int32 B) { return ObjectIndices[A] < ObjectIndices[B]; });
+		Permute(ObjectIndices, Order);
+		Permute(Objects, Order);
+		Permute(Values, Order);
+	}
+
+	// Get the position of the object index, INDEX_NONE if not found
+	FORCEINLINE int32 FindIndex(uint32 ObjectIndex) const
+	{
+		const int32 Pos = Algo::LowerBound(ObjectIndices, ObjectIndex);
+		return Pos < ObjectIndices.Num() && ObjectIndices[Pos] == ObjectIndex ? Pos : INDEX_NONE;
+	}
+
+	// Get the value of the object index, nullptr if not found
+	FORCEINLINE const ValueType* FindByObjectIndex(uint32 ObjectIndex) const
+	{
+		const int32 Pos = FindIndex(ObjectIndex);
+		return Pos != INDEX_NONE ? &Values[Pos] : nullptr;
+	}
+
+	// Get the value of the object, nullptr if not found
+	FORCEINLINE const ValueType* Find(const UObject* Object) const
+	{
+		return Object ? FindByObjectIndex(Object->GetUniqueID()) : nullptr;
+	}
+
+	// Check if the object has a result
+	FORCEINLINE bool Contains(const UObject* Object) const
+	{
+		return Object && FindIndex(Object->GetUniqueID()) != INDEX_NONE;
+	}
+
+private:
+	// Reorder the array with the given positions
+	template<typename ElementType>
+	static void Permute(TArray<ElementType>& Array, const TArray<int32>& Order)
+	{
+		TArray<ElementType> Sorted;
+		Sorted.Reserve(Order.Num());
+		for (const int32 Idx : Order)
+		{
+			Sorted.Add(MoveTemp(Array[Idx]));
+		}
+		Array = MoveTemp(Sorted);
+	}
+};
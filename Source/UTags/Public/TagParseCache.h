@@ -0,0 +1,107 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Tags.h"
+
+/**
+* Thread-safe, bounded FName -> FTagData parse cache
+*
+* Tag FNames are interned, a given name (compared case sensitive) always
+* parses to the same data, repeated reads of unchanged tags are a hash lookup
+*
+* When full a single entry is evicted with the clock (second chance) approximation
+* of LRU, hits only set the referenced flag of the entry under the read lock
+*/
+class UTAGS_API FTagParseCache
+{
+public:
+	// Shared, immutable parsed tag data
+	typedef TSharedRef<const FTagData, ESPMode::ThreadSafe> FTagDataRef;
+
+	// Default maximal number of cached tags
+	static constexpr int32 DefaultMaxEntries = 65536;
+
+	// Get the module wide cache
+	static FTagParseCache& Get();
+
+	// Get the parsed data of the tag (untyped tags have an empty type), parses and caches it on a miss
+	FTagDataRef GetTagData(const FName& InTag);
+
+	// Parse the tag without using the cache
+	static FTagData Parse(const FName& InTag);
+
+	// Remove all cached tags (the counters are kept)
+	void Empty();
+
+	// Set the maximal number of cached tags, entries above the new maximum are evicted
+	void SetMaxEntries(int32 InMaxEntries);
+
+	// Number of cached tags
+	int32 Num() const;
+
+	// Number of lookups answered from the cache
+	int64 GetHits() const { return Hits.GetValue(); }
+
+	// Number of lookups which had to parse the tag
+	int64 GetMisses() const { return Misses.GetValue(); }
+
+	// Reset the hit and miss counters
+	void ResetCounters();
+
+private:
+	// Cached parsed tag with its slot in the eviction clock
+	struct FEntry
+	{
+		FTagDataRef Data;
+		int32 SlotIndex;
+	};
+
+	// Eviction clock slot, the flag is set by the hits since the hand last passed
+	struct FSlot
+	{
+		FName Name;
+		FThreadSafeBool bReferenced;
+	};
+
+	// Compare the names case sensitive, same name with different case parses differently
+	struct FNameKeyFuncs : TDefaultMapKeyFuncs<FName, FEntry, false>
+	{
+		static FORCEINLINE bool Matches(const FName& A, const FName& B)
+		{
+			return A.IsEqual(B, ENameCase::CaseSensitive);
+		}
+		static FORCEINLINE uint32 GetKeyHash(const FName& Key)
+		{
+			return GetTypeHash(Key);
+		}
+	};
+
+	// Use Get()
+	FTagParseCache() : MaxEntries(DefaultMaxEntries), ClockHand(0) {}
+
+	// Store the parsed tag, evicts an entry if the cache is full (call with the write lock)
+	void AddEntry(const FName& InTag, const FTagDataRef& Parsed);
+
+	// Guards the entries
+	mutable FRWLock Lock;
+
+	// Cached parsed tags
+	TMap<FName, FEntry, FDefaultSetAllocator, FNameKeyFuncs> Entries;
+
+	// Eviction clock, one slot per entry
+	TArray<FSlot> Slots;
+
+	// Maximal number of entries
+	int32 MaxEntries;
+
+	// Next slot checked for eviction
+	int32 ClockHand;
+
+	// Counters
+	FThreadSafeCounter64 Hits;
+	FThreadSafeCounter64 Misses;
+};
@@ -0,0 +1,104 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "TagTypeRegistry.h"
+#include "TagStore.h"
+
+class AActor;
+class UActorComponent;
+
+/**
+* Prepared tag query, a conjunction of type, key and key value pair predicates
+*
+* The predicates are grouped by type and the type ids are resolved once, evaluating
+* the query rejects objects with a type mask test and tokenizes a single tag per type
+*
+*	const FTagQuery Query = FTagQuery().WithKeyValuePair("SemLog", "Class", "Cup").WithKey("SemLog", "Id");
+*	for (AActor* Act : FTags::GetActorsWithKeyValuePair(World, Query)) { ... }
+*/
+class UTAGS_API FTagQuery
+{
+public:
+	// Empty query, matches every actor and component
+	FTagQuery();
+
+	// Query for the tag type key value pair
+	FTagQuery(const FString& TagType, const FString& TagKey, const FString& TagValue);
+
+	// Require a tag of the type
+	FTagQuery& WithType(const FString& TagType);
+
+	// Require the key in the tag type
+	FTagQuery& WithKey(const FString& TagType, const FString& TagKey);
+
+	// Require the key value pair in the tag type
+	FTagQuery& WithKeyValuePair(const FString& TagType, const FString& TagKey, const FString& TagValue);
+
+	// Check if the query has no predicates
+	bool IsEmpty() const { return TypeTerms.Num() == 0; }
+
+	// Get the tag types required by the query
+	TArray<FString> GetTypes() const;
+
+	// Evaluate the query on the tags (the predicates apply to the first tag of each type, same as FTags)
+	bool Matches(const TArray<FName>& InTags) const;
+
+	// Evaluate the query on a copy of the tags and of the pending tag store values of their owner (safe off the game thread)
+	bool Matches(const TArray<FName>& InTags, const TArray<FTagStore::FPendingValue>& PendingValues) const;
+
+	// Evaluate the query on the actor tags (reading through the tag store)
+	bool Matches(AActor* Actor) const;
+
+	// Evaluate the query on the component tags (reading through the tag store)
+	bool Matches(UActorComponent* Component) const;
+
+	// Evaluate the query on the actor or component tags, false for other objects
+	bool Matches(UObject* Object) const;
+
+	// Call the callback with every matching actor and/or component of the world, return false from the callback to stop
+	void ForEachMatch(UWorld* World, bool bActors, bool bComponents, TFunctionRef<bool(UObject*)> Callback) const;
+
+private:
+	// Key (and value) predicate
+	struct FKeyTerm
+	{
+		FString Key;
+		FString Value;
+		bool bHasValue;
+	};
+
+	// Predicates on the first tag of a type
+	struct FTypeTerm
+	{
+		FString TagType;
+		int32 TypeId; // INDEX_NONE if the type had no id when the query was built
+		TArray<FKeyTerm> KeyTerms;
+	};
+
+	// Lookup of the pending tag store value of a type key
+	typedef TFunctionRef<FTagStore::EState(const FString& TagType, const FString& TagKey, FString& OutValue)> FFindStoredValue;
+
+	// Get the term of the type, adds it if needed
+	FTypeTerm& FindOrAddTypeTerm(const FString& TagType);
+
+	// Index of the first tag of the term type, INDEX_NONE if not found
+	static int32 FindTagIndex(const TArray<FName>& InTags, const FTypeTerm& TypeTerm);
+
+	// Evaluate the key predicates on a tag, the pending values (if any) override the tag
+	static bool MatchesKeyTerms(const FName& InTag, const FTypeTerm& TypeTerm, const FFindStoredValue* FindStoredValue);
+
+	// Evaluate the query on the tags, reading through the pending values (if any)
+	bool MatchesTags(const TArray<FName>& InTags, const FFindStoredValue* FindStoredValue) const;
+
+	// Evaluate the query on the tags of an object, after the type mask test
+	bool MatchesObjectTags(UObject* Object, const TArray<FName>& InTags) const;
+
+private:
+	// Predicates grouped by type
+	TArray<FTypeTerm> TypeTerms;
+
+	// Bits of the required types known when the query was built
+	FTagTypeRegistry::FTypeMask RequiredMask;
+};
@@ -0,0 +1,242 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "TagTokenizer.h"
+#include "TagStore.h"
+
+/**
+* Lazy range over the actors and/or components (depending on ObjectType) of the world
+* having the tag type key (and optionally the key value pair)
+*
+* Nothing is materialized, the world is walked while iterating, breaking out of the
+* loop stops the walk; the value view of an item is valid until the iterator advances;
+* the pending values of the tag store (if enabled) are read through
+*
+*	for (const auto& Item : TTagQueryRange<AActor>(World, "SemLog", "Class"))
+*	{
+*		if (Item.Value.Equals(TEXT("Cup"))) { ...; break; }
+*	}
+*/
+template<typename ObjectType>
+class TTagQueryRange
+{
+	// Which object kinds are visited
+	static constexpr bool bVisitActors = TIsDerivedFrom<AActor, ObjectType>::IsDerived || TIsDerivedFrom<ObjectType, AActor>::IsDerived;
+	static constexpr bool bVisitComponents = TIsDerivedFrom<UActorComponent, ObjectType>::IsDerived || TIsDerivedFrom<ObjectType, UActorComponent>::IsDerived;
+	static_assert(bVisitActors || bVisitComponents, "TTagQueryRange can only iterate actors and actor components");
+
+public:
+	// A matching object and its tag value
+	struct FItem
+	{
+		ObjectType* Object = nullptr;
+		FTagView Value;
+	};
+
+	// Forward iterator walking the levels, actors and components of the world
+	class FIterator
+	{
+	public:
+		// End iterator
+		FIterator() : Range(nullptr), LevelIdx(0), ActorIdx(0), CompIdx(0) {}
+
+		// Begin iterator, moves to the first match
+		explicit FIterator(const TTagQueryRange* InRange) : Range(InRange), LevelIdx(0), ActorIdx(-1), CompIdx(0)
+		{
+			Advance();
+		}
+
+		// Copies point the item value at their own buffer (the view would dangle with the source)
+		FIterator(const FIterator& Other)
+			: Range(Other.Range), LevelIdx(Other.LevelIdx), ActorIdx(Other.ActorIdx), CompIdx(Other.CompIdx)
+			, Components(Other.Components), Item(Other.Item), ValueBuffer(Other.ValueBuffer)
+		{
+			RebindValue();
+		}
+
+		FIterator& operator=(const FIterator& Other)
+		{
+			if (this != &Other)
+			{
+				Range = Other.Range;
+				LevelIdx = Other.LevelIdx;
+				ActorIdx = Other.ActorIdx;
+				CompIdx = Other.CompIdx;
+				Components = Other.Components;
+				Item = Other.Item;
+				ValueBuffer = Other.ValueBuffer;
+				RebindValue();
+			}
+			return *this;
+		}
+
+		FORCEINLINE const FItem& operator*() const { return Item; }
+		FORCEINLINE const FItem* operator->() const { return &Item; }
+		FORCEINLINE FIterator& operator++() { Advance(); return *this; }
+		FORCEINLINE bool operator!=(const FIterator& Other) const { return Range != Other.Range; }
+		FORCEINLINE explicit operator bool() const { return Range != nullptr; }
+
+	private:
+		// Move to the next matching object, or to the end
+		void Advance()
+		{
+			UWorld* World = Range ? Range->World.Get() : nullptr;
+			if (World == nullptr)
+			{
+				Range = nullptr;
+				return;
+			}
+			const TArray<ULevel*>& Levels = World->GetLevels();
+
+			while (true)
+			{
+				// Components of the current actor
+				while (CompIdx < Components.Num())
+				{
+					UActorComponent* Component = Components[CompIdx++];
+					if (Component && Match(Component, Component->ComponentTags))
+					{
+						return;
+					}
+				}
+
+				// Next actor
+				++ActorIdx;
+				while (LevelIdx < Levels.Num() && (Levels[LevelIdx] == nullptr || ActorIdx >= Levels[LevelIdx]->Actors.Num()))
+				{
+					++LevelIdx;
+					ActorIdx = 0;
+				}
+				if (LevelIdx >= Levels.Num())
+				{
+					Range = nullptr;
+					return;
+				}
+
+				AActor* Actor = Levels[LevelIdx]->Actors[ActorIdx];
+				Components.Reset();
+				CompIdx = 0;
+				if (Actor == nullptr || Actor->IsPendingKill())
+				{
+					continue;
+				}
+				if (bVisitComponents)
+				{
+					// Reuses the buffer allocation
+					Actor->GetComponents(Components);
+				}
+				if (bVisitActors && Match(Actor, Actor->Tags))
+				{
+					return;
+				}
+			}
+		}
+
+		// Check the object tags, store the value on a match
+		bool Match(UObject* Object, const TArray<FName>& InTags)
+		{
+			ObjectType* Typed = Cast<ObjectType>(Object);
+			if (Typed == nullptr)
+			{
+				return false;
+			}
+			for (const auto& TagItr : InTags)
+			{
+				FTagNameBuffer TagBuffer(TagItr);
+				const FTagTokenizer Tokenizer(TagBuffer.GetView());
+				if (Tokenizer.IsType(Range->TagType))
+				{
+					// Pending values of the tag store (if enabled) override the tag (same as FTags::GetValue)
+					const FTagStore* Store = FTagStore::Get();
+					const FTagStore::EState State = Store
+						? Store->FindValue(Object, Range->TagType, Range->TagKey, ValueBuffer)
+						: FTagStore::EState::None;
+					if (State != FTagStore::EState::None)
+					{
+						if (State == FTagStore::EState::Removed || ValueBuffer.IsEmpty()
+							|| (Range->bHasTagValue && !FTagView(ValueBuffer).Equals(Range->TagValue)))
+						{
+							return false;
+						}
+						Item.Object = Typed;
+						Item.Value = FTagView(ValueBuffer);
+						return true;
+					}
+
+					// Only the first tag of the type is checked (same as FTags::GetValue)
+					FTagView Value;
+					if (!Tokenizer.FindValue(Range->TagKey, Value) || Value.IsEmpty()
+						|| (Range->bHasTagValue && !Value.Equals(Range->TagValue)))
+					{
+						return false;
+					}
+					ValueBuffer.Reset();
+					ValueBuffer.AppendChars(Value.Data, Value.Len);
+					Item.Object = Typed;
+					Item.Value = FTagView(ValueBuffer);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Point the item value at the owned buffer
+		void RebindValue()
+		{
+			if (Item.Object)
+			{
+				Item.Value = FTagView(ValueBuffer);
+			}
+		}
+
+	private:
+		// The iterated range, nullptr at the end
+		const TTagQueryRange* Range;
+
+		// Walk state
+		int32 LevelIdx;
+		int32 ActorIdx;
+		int32 CompIdx;
+		TArray<UActorComponent*> Components;
+
+		// Current item, its value is copied into the reused buffer
+		FItem Item;
+		FString ValueBuffer;
+	};
+
+	// Range over the objects with the tag type key
+	TTagQueryRange(UWorld* InWorld, const FString& InTagType, const FString& InTagKey)
+		: World(InWorld), TagType(InTagType), TagKey(InTagKey), bHasTagValue(false)
+	{}
+
+	// Range over the objects with the tag type key value pair
+	TTagQueryRange(UWorld* InWorld, const FString& InTagType, const FString& InTagKey, const FString& InTagValue)
+		: World(InWorld), TagType(InTagType), TagKey(InTagKey), TagValue(InTagValue), bHasTagValue(true)
+	{}
+
+	FORCEINLINE FIterator begin() const { return FIterator(this); }
+	FORCEINLINE FIterator end() const { return FIterator(); }
+
+	// Get the first matching object, nullptr if none
+	ObjectType* First() const
+	{
+		FIterator Itr = begin();
+		return Itr ? Itr->Object : nullptr;
+	}
+
+private:
+	// The queried world
+	TWeakObjectPtr<UWorld> World;
+
+	// Query parameters
+	FString TagType;
+	FString TagKey;
+	FString TagValue;
+	bool bHasTagValue;
+};
@@ -0,0 +1,104 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Tags.h"
+
+/**
+* Incremental world tag scan, spread over frames under a time budget
+*
+* The actors of the world are collected on the first tick, then parsed in
+* chunks (actor and its components) until the per frame budget is used up;
+* the progress is kept between frames, actors destroyed mid-scan are skipped
+*
+* The completion callback runs on the game thread with the same result the
+* synchronous FTags function returns (without the objects destroyed during the scan);
+* the job keeps itself alive until it completes or is cancelled
+*/
+class UTAGS_API FTagScanJob : public TSharedFromThis<FTagScanJob>
+{
+public:
+	// Default time budget per frame in milliseconds
+	static constexpr double DefaultBudgetMs = 1.0;
+
+	// Incremental FTags::GetWorldTagsData
+	static TSharedRef<FTagScanJob> ScanWorldTagsData(UWorld* World,
+		TFunction<void(const TMap<TWeakObjectPtr<UObject>, TArray<FTagData>>&)> OnComplete,
+		double BudgetMs = DefaultBudgetMs);
+
+	// Incremental FTags::GetObjectKeyValuePairsMap (completes on the first tick if the world tag index is enabled)
+	static TSharedRef<FTagScanJob> ScanObjectKeyValuePairsMap(UWorld* World, const FString& TagType,
+		TFunction<void(const TMap<UObject*, TMap<FString, FString>>&)> OnComplete,
+		double BudgetMs = DefaultBudgetMs);
+
+	// Stop the scan on the next tick, the completion callback is not called
+	void Cancel();
+
+	// True until the scan completes, is cancelled, or its world is destroyed
+	bool IsRunning() const { return State == EState::Running; }
+
+	// True if the scan completed and the callback was called
+	bool IsComplete() const { return State == EState::Complete; }
+
+	// Scanned fraction of the actors [0, 1]
+	float GetProgress() const;
+
+	// Number of frames the scan has run in
+	int32 NumFrames() const { return Frames; }
+
+private:
+	// Scan state
+	enum class EState : uint8
+	{
+		Running,
+		Complete,
+		Cancelled
+	};
+
+	// Use the Scan* functions
+	FTagScanJob(UWorld* InWorld, double BudgetMs);
+
+	// Register the job to the ticker, the ticker holds the job until it finishes
+	void Start();
+
+	// Scan until the budget is used up, false when done
+	bool Tick(float DeltaTime);
+
+	// Parse the actor and its components
+	void ScanActor(AActor* Actor);
+
+	// Finish the scan with the given state
+	void Finish(EState InState);
+
+private:
+	// Scanned world
+	TWeakObjectPtr<UWorld> World;
+
+	// Time budget per frame
+	double BudgetSeconds;
+
+	// Actors collected on the first tick
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	// Index of the next actor to scan
+	int32 NextActor;
+
+	// True once the actors are collected
+	bool bGathered;
+
+	// Frames run so far
+	int32 Frames;
+
+	// Current state
+	EState State;
+
+	// Complete the scan at once (e.g. from the tag index), false to scan incrementally
+	TFunction<bool(UWorld*)> TryCompleteAtOnce;
+
+	// Parse the tags of an actor or component into the partial result
+	TFunction<void(UObject*, const TArray<FName>&)> VisitObject;
+
+	// Build the final result and call the completion callback
+	TFunction<void()> OnFinished;
+};
@@ -0,0 +1,103 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Tags.h"
+
+class FTagSnapshot;
+
+// Shared reference to an immutable snapshot, safe to copy and release from any thread
+typedef TSharedPtr<const FTagSnapshot, ESPMode::ThreadSafe> FTagSnapshotPtr;
+
+/**
+* Immutable copy of the parsed tags of a world, built on the game thread
+* and published per world; other threads get the latest published version
+* and query it without locks, the game thread meanwhile builds the next one
+*
+* Objects are identified by FObjectKey, which is safe to hash and compare
+* from any thread (resolve it back to the object on the game thread only)
+*/
+class UTAGS_API FTagSnapshot
+{
+public:
+	// Build a snapshot of the actors and components of the world (game thread)
+	static FTagSnapshotPtr Build(UWorld* World);
+
+	// Build the next version of the world snapshot and publish it (game thread)
+	static FTagSnapshotPtr Publish(UWorld* World);
+
+	// Drop the published snapshot of the world, readers keep their references
+	static void Unpublish(UWorld* World);
+
+	// Get the latest published snapshot of the world (any thread), nullptr if none is published
+	static FTagSnapshotPtr GetLatest(const FObjectKey& WorldKey);
+	static FTagSnapshotPtr GetLatest(UWorld* World) { return GetLatest(FObjectKey(World)); }
+
+	// Published version, increasing with every Publish() of the world (0 if built without publishing)
+	int64 GetVersion() const { return Version; }
+
+	// Number of objects with tags
+	int32 Num() const { return ObjectTags.Num(); }
+
+	// Get the tags data of the object, nullptr if the object has no tags
+	const TArray<FTagData>* FindObjectTags(const FObjectKey& ObjectKey) const;
+
+	// Get the key value pairs of the tag type of the object, nullptr if the object has no such tag
+	const TMap<FString, FString>* FindKeyValuePairs(const FObjectKey& ObjectKey, const FString& TagType) const;
+
+	// Get the value of the tag type key of the object, false if not found
+	bool GetValue(const FObjectKey& ObjectKey, const FString& TagType, const FString& TagKey, FString& OutValue) const;
+
+	// Get the objects with the tag type, nullptr if none
+	const TArray<FObjectKey>* FindObjectsWithType(const FString& TagType) const;
+
+	// Get the objects with the tag type key value pair, nullptr if none
+	const TArray<FObjectKey>* FindObjectsWithKeyValuePair(const FString& TagType, const FString& TagKey, const FString& TagValue) const;
+
+	// Call the functor with every object having the tag type key and its value
+	template<typename FunctorType>
+	void ForEachObjectWithKey(const FString& TagType, const FString& TagKey, FunctorType&& Functor) const
+	{
+		if (const TMap<FString, TMap<FString, TArray<FObjectKey>>>* KeyMap = Entries.Find(TagType))
+		{
+			if (const TMap<FString, TArray<FObjectKey>>* ValueMap = KeyMap->Find(TagKey))
+			{
+				for (const auto& ValueToObjects : *ValueMap)
+				{
+					for (const FObjectKey& ObjectKey : ValueToObjects.Value)
+					{
+						Functor(ObjectKey, ValueToObjects.Key);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	// Use Build() or Publish()
+	FTagSnapshot() : Version(0) {}
+
+	// Add the tags data of the object and its lookup entries
+	void AddObject(UObject* Object, const TArray<FTagData>& TagsData);
+
+	// Build the snapshot with the given version
+	static FTagSnapshot* BuildSnapshot(UWorld* World, int64 InVersion);
+
+	// Drop the snapshot of the world which is cleaned up
+	static void OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
+
+private:
+	// Published version
+	int64 Version;
+
+	// Object -> tags data (one entry per tag type)
+	TMap<FObjectKey, TArray<FTagData>> ObjectTags;
+
+	// TagType -> Objects
+	TMap<FString, TArray<FObjectKey>> TypeToObjects;
+
+	// TagType -> Key -> Value -> Objects
+	TMap<FString, TMap<FString, TMap<FString, TArray<FObjectKey>>>> Entries;
+};
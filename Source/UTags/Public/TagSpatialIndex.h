@@ -0,0 +1,150 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "TagQuery.h"
+
+/**
+* Opt-in spatial index of the tagged actors of a world, a uniform grid per tag type
+*
+* Actors are bucketed by the cell of their location in the grid of every tag type
+* they have; the grids are updated from the root component transform changes,
+* actor spawn/destroy, level streaming and the FTags mutators
+*
+* Combined tag and spatial queries visit only the cells around the query
+* in the grid of the least populated tag type of the query
+*/
+class UTAGS_API FTagSpatialIndex
+{
+public:
+	// Default edge length of the grid cells (cm)
+	static constexpr float DefaultCellSize = 200.f;
+
+	// Create and build the spatial index of the world (returns the existing one if already enabled)
+	static FTagSpatialIndex* Enable(UWorld* World, float CellSize = DefaultCellSize);
+
+	// Remove the spatial index of the world
+	static void Disable(UWorld* World);
+
+	// Get the spatial index of the world, nullptr if it is not enabled
+	static FTagSpatialIndex* Get(UWorld* World);
+
+	// Unregister from the world, engine and transform events
+	~FTagSpatialIndex();
+
+	// Clear and re-index all the actors of the world
+	void Rebuild();
+
+	// (Re)index the actor with the tag types and location it has now
+	void AddActor(AActor* Actor);
+
+	// Remove the actor from the index
+	void RemoveActor(AActor* Actor);
+
+	// Remove the entries of the destroyed (garbage collected) actors, returns the number of removed entries
+	int32 Compact();
+
+	// Number of indexed actors
+	int32 Num() const { return ActorEntries.Num(); }
+
+	// Edge length of the grid cells
+	float GetCellSize() const { return CellSize; }
+
+	// Get the actors matching the query inside the box, false if the query has no tag type (the index cannot answer it)
+	bool FindActorsInBox(const FTagQuery& Query, const FBox& Box, TArray<AActor*>& OutActors) const;
+
+	// Get the actors matching the query inside the sphere, false if the query has no tag type
+	bool FindActorsInSphere(const FTagQuery& Query, const FVector& Center, float Radius, TArray<AActor*>& OutActors) const;
+
+	// Get the (up to) K actors matching the query closest to the location (within the max distance), closest first, false if the query has no tag type
+	bool FindNearestActors(const FTagQuery& Query, const FVector& Location, int32 K, float MaxDistance, TArray<AActor*>& OutActors) const;
+
+private:
+	// Indexed actor
+	struct FActorEntry
+	{
+		TArray<FString> TagTypes;
+		FVector Location;
+		FIntVector Cell;
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle TransformHandle;
+	};
+
+	// Actor in a grid cell, with its indexed location
+	struct FCellEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location;
+	};
+
+	// Grid of the actors of a tag type (the cell bounds only grow until the next rebuild)
+	struct FGrid
+	{
+		TMap<FIntVector, TArray<FCellEntry>> Cells;
+		FIntVector MinCell;
+		FIntVector MaxCell;
+		int32 NumActors = 0;
+	};
+
+	// Use Enable() to create the index
+	FTagSpatialIndex(UWorld* InWorld, float InCellSize);
+
+	// Get the cell of the location
+	FIntVector GetCell(const FVector& Location) const;
+
+	// Add or remove the actor to/from the cell of the tag type grid
+	void AddToGrid(const FString& TagType, const FIntVector& Cell, const TWeakObjectPtr<AActor>& ActorPtr, const FVector& Location);
+	void RemoveFromGrid(const FString& TagType, const FIntVector& Cell, const TWeakObjectPtr<AActor>& ActorPtr);
+
+	// Remove the actor entry and its transform binding
+	void RemoveEntry(const TWeakObjectPtr<AActor>& ActorPtr);
+
+	// Get the grid of the least populated tag type of the query, false if the query has no tag type
+	bool FindQueryGrid(const FTagQuery& Query, const FGrid*& OutGrid) const;
+
+	// Call the functor with the valid actors matching the query in the cells of the range, with their indexed location
+	void ForEachInCells(const FGrid& Grid, const FTagQuery& Query, const FIntVector& MinCell, const FIntVector& MaxCell, TFunctionRef<void(AActor*, const FVector&)> Functor) const;
+
+	// Call the functor with the valid actors matching the query in the cell
+	static void ForEachInCell(const TArray<FCellEntry>& CellEntries, const FTagQuery& Query, TFunctionRef<void(AActor*, const FVector&)> Functor);
+
+	// Move the actor to the cell of its new location
+	void OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	// Callbacks
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnTagsChanged(UObject* Owner);
+	void OnLevelAdded(ULevel* InLevel, UWorld* InWorld);
+	void OnLevelRemoved(ULevel* InLevel, UWorld* InWorld);
+	void OnPostGarbageCollect();
+	static void OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
+
+	// Access to the enabled world spatial indices
+	static TMap<TWeakObjectPtr<UWorld>, TUniquePtr<FTagSpatialIndex>>& GetWorldIndices();
+
+private:
+	// The indexed world
+	TWeakObjectPtr<UWorld> World;
+
+	// Edge length of the grid cells
+	float CellSize;
+
+	// TagType -> grid of the actors with the tag type
+	TMap<FString, FGrid> Grids;
+
+	// Actor -> indexed entry
+	TMap<TWeakObjectPtr<AActor>, FActorEntry> ActorEntries;
+
+	// Event handles
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle TagsChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
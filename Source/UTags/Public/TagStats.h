@@ -0,0 +1,180 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+struct FTagData;
+template<typename ValueType> struct TTagObjectResults;
+
+// Collect the per function totals (the cycle stats follow the engine STATS setting)
+#ifndef UTAGS_STATS
+#define UTAGS_STATS !UE_BUILD_SHIPPING
+#endif
+
+DECLARE_STATS_GROUP(TEXT("UTags"), STATGROUP_UTags, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Calls"), STAT_UTags_Calls, STATGROUP_UTags, UTAGS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Objects visited"), STAT_UTags_ObjectsVisited, STATGROUP_UTags, UTAGS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tags parsed"), STAT_UTags_TagsParsed, STATGROUP_UTags, UTAGS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Result bytes"), STAT_UTags_ResultBytes, STATGROUP_UTags, UTAGS_API);
+
+/**
+* Call counts, cycles, visited objects, parsed tags and result bytes of the FTags functions,
+* nested FTags calls are attributed to the outermost call
+*
+* Console commands: UTags.DumpStats, UTags.ResetStats, UTags.StatsResultBytes [0/1]
+*/
+class UTAGS_API FTagStats
+{
+public:
+	// Totals of a function (all overloads share the same entry)
+	struct FFunctionStats
+	{
+		const TCHAR* Name;
+		FThreadSafeCounter64 Calls;
+		FThreadSafeCounter64 Cycles;
+		FThreadSafeCounter64 ObjectsVisited;
+		FThreadSafeCounter64 TagsParsed;
+		FThreadSafeCounter64 ResultBytes;
+	};
+
+	// Records the function call if it is the outermost FTags call of the thread
+	class UTAGS_API FScope
+	{
+	public:
+		explicit FScope(FFunctionStats& InStats);
+		~FScope();
+
+	private:
+		FFunctionStats& Stats;
+		uint64 StartCycles;
+		int64 StartObjectsVisited;
+		int64 StartTagsParsed;
+		int64 StartResultBytes;
+		bool bOutermost;
+	};
+
+	class FTaskScope;
+
+	// Attributes the counts of parallel tasks to the FTags call that started them
+	class UTAGS_API FParallelScope
+	{
+	public:
+		FParallelScope();
+		~FParallelScope();
+
+	private:
+		friend class FTaskScope;
+		uint32 ThreadId;
+		FThreadSafeCounter64 ObjectsVisited;
+		FThreadSafeCounter64 TagsParsed;
+	};
+
+	// Scope of a parallel task, the FTags calls of the task are nested in the starting call
+	class UTAGS_API FTaskScope
+	{
+	public:
+		explicit FTaskScope(FParallelScope& InParent);
+		~FTaskScope();
+
+	private:
+		FParallelScope& Parent;
+		int64 StartObjectsVisited;
+		int64 StartTagsParsed;
+	};
+
+	// Get the entry of the function, added on the first call
+	static FFunctionStats& FindOrAdd(const TCHAR* Name);
+
+	// Count the visited objects of the current call
+	static void AddObjectsVisited(int32 Num);
+
+	// Count the parsed tags of the current call
+	static void AddTagsParsed(int32 Num);
+
+	// Count the allocated bytes of the returned container (if enabled, walks the result)
+	template<typename ResultType>
+	static void AddResultBytes(const ResultType& Result)
+	{
+		if (IsTrackingResultBytes())
+		{
+			AddResultBytesNum(GetDeepAllocatedSize(Result));
+		}
+	}
+
+	// Check if the result containers are measured (off by default, it walks the results)
+	static bool IsTrackingResultBytes();
+
+	// Log the per function totals, sorted by time
+	static void Dump();
+
+	// Clear the per function totals
+	static void Reset();
+
+private:
+	// Count the allocated bytes of the current call
+	static void AddResultBytesNum(SIZE_T Num);
+
+	// Allocated size of the results, including the nested containers and strings
+	template<typename T>
+	static SIZE_T GetDeepAllocatedSize(const T&) { return 0; }
+	static SIZE_T GetDeepAllocatedSize(const FString& Str) { return Str.GetAllocatedSize(); }
+	template<typename T>
+	static SIZE_T GetDeepAllocatedSize(const TArray<T>& Arr)
+	{
+		SIZE_T Size = Arr.GetAllocatedSize();
+		for (const auto& Elem : Arr)
+		{
+			Size += GetDeepAllocatedSize(Elem);
+		}
+		return Size;
+	}
+	template<typename T>
+	static SIZE_T GetDeepAllocatedSize(const TSet<T>& Set)
+	{
+		SIZE_T Size = Set.GetAllocatedSize();
+		for (const auto& Elem : Set)
+		{
+			Size += GetDeepAllocatedSize(Elem);
+		}
+		return Size;
+	}
+	template<typename KeyType, typename ValueType>
+	static SIZE_T GetDeepAllocatedSize(const TMap<KeyType, ValueType>& Map)
+	{
+		SIZE_T Size = Map.GetAllocatedSize();
+		for (const auto& Pair : Map)
+		{
+			Size += GetDeepAllocatedSize(Pair.Key) + GetDeepAllocatedSize(Pair.Value);
+		}
+		return Size;
+	}
+	static SIZE_T GetDeepAllocatedSize(const FTagData& Data);
+	template<typename ValueType>
+	static SIZE_T GetDeepAllocatedSize(const TTagObjectResults<ValueType>& Results)
+	{
+		return GetDeepAllocatedSize(Results.ObjectIndices) + GetDeepAllocatedSize(Results.Objects) + GetDeepAllocatedSize(Results.Values);
+	}
+};
+
+#if UTAGS_STATS
+// Cycle stat and per function totals of an FTags function
+#define UTAGS_SCOPE_CYCLE_COUNTER(Function) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FTags::" #Function), STAT_UTags_##Function, STATGROUP_UTags); \
+	static FTagStats::FFunctionStats& UTagsFunctionStats = FTagStats::FindOrAdd(TEXT(#Function)); \
+	const FTagStats::FScope UTagsStatScope(UTagsFunctionStats)
+#define UTAGS_STAT_OBJECTS_VISITED(Num) FTagStats::AddObjectsVisited(Num)
+#define UTAGS_STAT_TAGS_PARSED(Num) FTagStats::AddTagsParsed(Num)
+#define UTAGS_STAT_RESULT_BYTES(Result) FTagStats::AddResultBytes(Result)
+#define UTAGS_STAT_PARALLEL_SCOPE(Name) FTagStats::FParallelScope Name
+#define UTAGS_STAT_TASK_SCOPE(Parent) const FTagStats::FTaskScope UTagsTaskScope(Parent)
+#else
+#define UTAGS_SCOPE_CYCLE_COUNTER(Function)
+#define UTAGS_STAT_OBJECTS_VISITED(Num)
+#define UTAGS_STAT_TAGS_PARSED(Num)
+#define UTAGS_STAT_RESULT_BYTES(Result)
+#define UTAGS_STAT_PARALLEL_SCOPE(Name)
+#define UTAGS_STAT_TASK_SCOPE(Parent)
+#endif // UTAGS_STATS
@@ -0,0 +1,142 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "TagTokenizer.h"
+
+struct FTagData;
+
+/**
+* Opt-in runtime side store of the tag values of actors and components
+*
+* While enabled, the FTags mutators write the values of the already existing
+* tag types of actors and components into a compact per object table instead
+* of building a new FName per change (FNames are never freed, values updated
+* every frame would grow the name table without bound)
+*
+* The FTags actor and component getters, queries, world scans, struct reads
+* and the world tag index read through the store, the asynchronous queries
+* read a copy of the pending values taken with the tags; the pending values
+* are written to the tags (as FNames) only on Flush(), when the object is
+* saved, when it is edited with an FTagEditor, when it is selected in the
+* editor (the Details panel shows the tags as of the selection, values set
+* afterwards are shown once flushed or reselected), or when the store is
+* disabled; the values of destroyed objects are dropped after garbage collection
+*/
+class UTAGS_API FTagStore
+{
+public:
+	// Pending state of a key
+	enum class EState : uint8
+	{
+		None,
+		Set,
+		Removed
+	};
+
+	// A pending key value
+	struct FPendingValue
+	{
+		FString TagType;
+		FString Key;
+		FString Value;
+		bool bRemoved;
+	};
+
+	// Create the store (returns the existing one if already enabled)
+	static FTagStore* Enable();
+
+	// Flush all pending values and remove the store
+	static void Disable();
+
+	// Get the store, nullptr if it is not enabled
+	static FTagStore* Get();
+
+	// Unregister from the engine events
+	~FTagStore();
+
+	// Check if the tags array is the tags array of the actor or component owner
+	static bool IsOwnerTags(UObject* Owner, const TArray<FName>& InTags);
+
+	// Set the value of an existing tag type key, false if bReplaceExisting is false and the key already has a value
+	bool SetValue(UObject* Owner, const TArray<FName>& OwnerTags, const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bReplaceExisting);
+
+	// Remove the key of the tag type, false if the key has no value
+	bool RemoveValue(UObject* Owner, const TArray<FName>& OwnerTags, const FString& TagType, const FString& TagKey);
+
+	// Get the pending state of the key, the value is set if the state is Set
+	EState FindValue(UObject* Owner, const FString& TagType, const FString& TagKey, FString& OutValue) const;
+
+	// Apply the pending values of the object to the key value pairs of the tag type
+	void ApplyPending(UObject* Owner, const FString& TagType, TMap<FString, FString>& InOutKeyValuePairs) const;
+
+	// Apply the pending values of the object to its parsed tags data
+	void ApplyPending(UObject* Owner, TArray<FTagData>& InOutTagsData) const;
+
+	// Copy the pending values of the object (e.g. to read them off the game thread), false if it has none
+	bool CopyPending(UObject* Owner, TArray<FPendingValue>& OutValues) const;
+
+	// Get the state of the key in copied pending values, the value is set if the state is Set
+	static EState FindValue(const TArray<FPendingValue>& Values, const FString& TagType, const FString& TagKey, FString& OutValue);
+
+	// Apply copied pending values to the key value pairs of the tag type
+	static void ApplyPending(const TArray<FPendingValue>& Values, const FString& TagType, TMap<FString, FString>& InOutKeyValuePairs);
+
+	// Check if the object has pending values
+	bool HasPending(UObject* Owner) const;
+
+	// Write the pending values of the object to its tags, returns the number of written values
+	int32 Flush(UObject* Owner);
+
+	// Write the pending values of all objects, returns the number of written values
+	int32 FlushAll();
+
+	// Drop the pending values of the object
+	void Discard(UObject* Owner);
+
+	// Number of objects with pending values
+	int32 NumPendingObjects() const;
+
+private:
+	// Use Enable() to create the store
+	FTagStore();
+
+	// Find the pending value of the key
+	static FPendingValue* FindPending(TArray<FPendingValue>& Values, const FString& TagType, const FString& TagKey);
+	static const FPendingValue* FindPending(const TArray<FPendingValue>& Values, const FString& TagType, const FString& TagKey);
+
+	// Store the pending value and notify the tag listeners
+	void SetPending(UObject* Owner, const FString& TagType, const FString& TagKey, const FTagView& TagValue, bool bRemoved);
+
+	// Write the values to the tags of the owner
+	static int32 WriteValues(UObject* Owner, const TArray<FPendingValue>& Values);
+
+	// Flush the objects which are saved
+	void OnObjectSaved(UObject* Object);
+
+	// Drop the pending values of the destroyed (collected) objects
+	void OnPostGarbageCollect();
+
+#if WITH_EDITOR
+	// Flush the objects selected in the editor, so the Details panel shows their values
+	void OnObjectSelected(UObject* Object);
+#endif // WITH_EDITOR
+
+	// Access to the store instance
+	static TUniquePtr<FTagStore>& GetInstance();
+
+private:
+	// Guards the pending values
+	mutable FRWLock Lock;
+
+	// Object -> pending values
+	TMap<TWeakObjectPtr<UObject>, TArray<FPendingValue>> Pending;
+
+	// Event handles
+	FDelegateHandle ObjectSavedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+#if WITH_EDITOR
+	FDelegateHandle ObjectSelectedHandle;
+#endif // WITH_EDITOR
+};
@@ -0,0 +1,73 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+
+class UProperty;
+class FTagEditor;
+struct FTagView;
+
+/**
+* Maps the key value pairs of a tag type onto the UPROPERTY fields of a USTRUCT,
+* the key of a field is the property name (compared ignoring case)
+*
+* Bindable fields: numbers, bool, enums, strings, names, object references
+* (as text) and FVector / FQuat / FTransform (in the FTagValue format);
+* containers, static arrays and other structs are ignored
+*
+* The key to field layout of every struct is computed once and cached
+*/
+class UTAGS_API FTagStructBinding
+{
+public:
+	// Fill the struct fields from the tag type key value pairs in a single parse, returns the number of set fields
+	// (the pending tag store values of the owner, if given, override the pairs of the tags)
+	static int32 Read(const TArray<FName>& InTags, const FString& TagType, const UScriptStruct* Struct, void* OutData, UObject* Owner = nullptr);
+
+	// Write the struct fields as key value pairs of the tag type, committed as one tag, false if nothing changed
+	static bool Write(TArray<FName>& InTags, const FString& TagType, const UScriptStruct* Struct, const void* InData, UObject* Owner = nullptr);
+	static bool Write(AActor* Actor, const FString& TagType, const UScriptStruct* Struct, const void* InData);
+	static bool Write(UActorComponent* Component, const FString& TagType, const UScriptStruct* Struct, const void* InData);
+
+private:
+	// How the field value is converted
+	enum class EFieldKind : uint8
+	{
+		Text,
+		Vector,
+		Quat,
+		Transform
+	};
+
+	// Bound field of the struct
+	struct FField
+	{
+		FString Key;
+		UProperty* Property;
+		EFieldKind Kind;
+	};
+
+	// Bound fields of a struct
+	struct FLayout
+	{
+		TWeakObjectPtr<const UScriptStruct> Struct;
+		TArray<FField> Fields;
+	};
+
+	// Access to the cached layouts
+	static TMap<const UScriptStruct*, TUniquePtr<FLayout>>& GetLayouts();
+
+	// Get the cached layout of the struct, computed on first use
+	static const FLayout& GetLayout(const UScriptStruct* Struct);
+
+	// Compute the bound fields of the struct
+	static void BuildLayout(const UScriptStruct* Struct, FLayout& OutLayout);
+
+	// Set the field bound to the key from the text value, false if there is no such field or the value is invalid
+	static bool ReadField(const FLayout& Layout, const FTagView& Key, const FTagView& Value, void* OutData, FString& ValueText);
+
+	// Write the fields into the editor
+	static bool WriteFields(FTagEditor& Editor, const FString& TagType, const UScriptStruct* Struct, const void* InData);
+};
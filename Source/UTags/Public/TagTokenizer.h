@@ -0,0 +1,284 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+* Non-owning view over a part of a tag string
+*/
+struct FTagView
+{
+	// Start of the viewed characters (not null terminated)
+	const TCHAR* Data;
+
+	// Number of viewed characters
+	int32 Len;
+
+	// Empty view
+	FTagView() : Data(TEXT("")), Len(0) {}
+
+	// View over the given characters
+	FTagView(const TCHAR* InData, int32 InLen) : Data(InData), Len(InLen) {}
+
+	// View over the whole string (the string must outlive the view)
+	FTagView(const FString& InString) : Data(*InString), Len(InString.Len()) {}
+
+	// View over a null terminated string (the string must outlive the view)
+	FTagView(const TCHAR* InString) : Data(InString), Len(FCString::Strlen(InString)) {}
+
+	// Check if the view has no characters
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Len == 0;
+	}
+
+	// Compare the viewed characters (ignores case by default, same as FString::Find)
+	FORCEINLINE bool Equals(const FTagView& Other, ESearchCase::Type SearchCase = ESearchCase::IgnoreCase) const
+	{
+		if (Len != Other.Len)
+		{
+			return false;
+		}
+		return SearchCase == ESearchCase::IgnoreCase
+			? FCString::Strnicmp(Data, Other.Data, Len) == 0
+			: FCString::Strncmp(Data, Other.Data, Len) == 0;
+	}
+
+	// Check if the view starts with the prefix (ignores case)
+	FORCEINLINE bool StartsWith(const FTagView& Prefix) const
+	{
+		return Len >= Prefix.Len && FCString::Strnicmp(Data, Prefix.Data, Prefix.Len) == 0;
+	}
+
+	// Check if the view ends with the suffix (ignores case)
+	FORCEINLINE bool EndsWith(const FTagView& Suffix) const
+	{
+		return Len >= Suffix.Len && FCString::Strnicmp(Data + Len - Suffix.Len, Suffix.Data, Suffix.Len) == 0;
+	}
+
+	// Match the glob pattern, '*' matches any characters and '?' a single one (ignores case)
+	bool MatchesWildcard(const FTagView& Pattern) const
+	{
+		int32 Idx = 0;
+		int32 PatternIdx = 0;
+		// Position of the last star and the text position it currently matches up to
+		int32 StarIdx = INDEX_NONE;
+		int32 StarMatchIdx = 0;
+		while (Idx < Len)
+		{
+			if (PatternIdx < Pattern.Len && Pattern.Data[PatternIdx] == TEXT('*'))
+			{
+				StarIdx = PatternIdx++;
+				StarMatchIdx = Idx;
+			}
+			else if (PatternIdx < Pattern.Len && (Pattern.Data[PatternIdx] == TEXT('?') || FChar::ToLower(Pattern.Data[PatternIdx]) == FChar::ToLower(Data[Idx])))
+			{
+				++Idx;
+				++PatternIdx;
+			}
+			else if (StarIdx != INDEX_NONE)
+			{
+				// Let the last star match one more character
+				PatternIdx = StarIdx + 1;
+				Idx = ++StarMatchIdx;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		while (PatternIdx < Pattern.Len && Pattern.Data[PatternIdx] == TEXT('*'))
+		{
+			++PatternIdx;
+		}
+		return PatternIdx == Pattern.Len;
+	}
+
+	// Return the index of the first occurrence of the character, INDEX_NONE if not found
+	FORCEINLINE int32 Find(TCHAR InChar, int32 StartIndex = 0) const
+	{
+		for (int32 Idx = StartIndex; Idx < Len; ++Idx)
+		{
+			if (Data[Idx] == InChar)
+			{
+				return Idx;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	// Copy the viewed characters to a new string
+	FString ToString() const
+	{
+		return FString(Len, Data);
+	}
+};
+
+
+/**
+* Zero-allocation tokenizer of a tag string:
+* ["TagType;Key1,Value1;Key2,Value2;"] -> TagType, (Key1, Value1), (Key2, Value2)
+*
+* Key/value views point into the tokenized tag, they are valid as long as the tag is
+*/
+class FTagTokenizer
+{
+public:
+	// Split the tag type, the tag is typed only if it contains the type separator
+	explicit FTagTokenizer(const FTagView& InTag) : Tag(InTag), PairsStart(InTag.Len), Pos(InTag.Len), bHasType(false)
+	{
+		const int32 TypeEnd = InTag.Find(TEXT(';'));
+		if (TypeEnd != INDEX_NONE)
+		{
+			Type = FTagView(InTag.Data, TypeEnd);
+			PairsStart = TypeEnd + 1;
+			Pos = PairsStart;
+			bHasType = true;
+		}
+	}
+
+	// Check if the tag has a type (it contains the type separator)
+	FORCEINLINE bool HasType() const
+	{
+		return bHasType;
+	}
+
+	// Get the tag type
+	FORCEINLINE const FTagView& GetType() const
+	{
+		return Type;
+	}
+
+	// Check if the tag is of the given type
+	FORCEINLINE bool IsType(const FTagView& InType) const
+	{
+		return HasType() && Type.Equals(InType);
+	}
+
+	// Move to the next key value pair (segments without a comma are skipped), false if no pairs left
+	bool Next(FTagView& OutKey, FTagView& OutValue)
+	{
+		while (Pos < Tag.Len)
+		{
+			const TCHAR* Segment = Tag.Data + Pos;
+			int32 SegmentLen = 0;
+			while (Pos + SegmentLen < Tag.Len && Segment[SegmentLen] != TEXT(';'))
+			{
+				++SegmentLen;
+			}
+			// Skip the segment and its separator
+			Pos += SegmentLen + 1;
+
+			// Split on the first comma
+			for (int32 Idx = 0; Idx < SegmentLen; ++Idx)
+			{
+				if (Segment[Idx] == TEXT(','))
+				{
+					OutKey = FTagView(Segment, Idx);
+					OutValue = FTagView(Segment + Idx + 1, SegmentLen - Idx - 1);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	// Restart the key value pairs iteration
+	FORCEINLINE void Reset()
+	{
+		Pos = PairsStart;
+	}
+
+	// Find the value of the first pair with the given key
+	bool FindValue(const FTagView& InKey, FTagView& OutValue) const
+	{
+		FTagTokenizer Pairs(*this);
+		Pairs.Reset();
+		FTagView CurrKey;
+		while (Pairs.Next(CurrKey, OutValue))
+		{
+			if (CurrKey.Equals(InKey))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Check if the tag has a pair with the given key
+	FORCEINLINE bool HasKey(const FTagView& InKey) const
+	{
+		FTagView Value;
+		return FindValue(InKey, Value);
+	}
+
+	// Check if the tag has the given key value pair
+	bool HasKeyValuePair(const FTagView& InKey, const FTagView& InValue) const
+	{
+		FTagTokenizer Pairs(*this);
+		Pairs.Reset();
+		FTagView CurrKey, CurrValue;
+		while (Pairs.Next(CurrKey, CurrValue))
+		{
+			if (CurrKey.Equals(InKey) && CurrValue.Equals(InValue))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	// The tokenized tag
+	FTagView Tag;
+
+	// The tag type
+	FTagView Type;
+
+	// Index of the first key value pair
+	int32 PairsStart;
+
+	// Current iteration index
+	int32 Pos;
+
+	// True if the tag contains the type separator
+	bool bHasType;
+};
+
+
+/**
+* Copies the string of a tag FName into a reused thread local buffer,
+* no heap allocations happen once the buffers are warmed up
+*
+* Nested buffers are supported (up to a fixed depth, deeper ones own their string)
+*/
+class UTAGS_API FTagNameBuffer
+{
+public:
+	// Copy the name into a free buffer
+	explicit FTagNameBuffer(const FName& InName);
+
+	// Release the buffer
+	~FTagNameBuffer();
+
+	// View over the name string, valid for the lifetime of the buffer
+	FORCEINLINE FTagView GetView() const
+	{
+		return FTagView(*Buffer);
+	}
+
+private:
+	// Non-copyable, the view points into the buffer
+	FTagNameBuffer(const FTagNameBuffer&) = delete;
+	FTagNameBuffer& operator=(const FTagNameBuffer&) = delete;
+
+	// Used buffer (pooled or the fallback)
+	FString* Buffer;
+
+	// Owned buffer, if the pool is exhausted
+	FString Fallback;
+
+	// True if the buffer is from the thread local pool
+	bool bPooled;
+};
@@ -0,0 +1,118 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+* Assigns small integer ids to the tag types in use and caches
+* - the type id of every seen tag name
+* - the bitmask of the types carried by an actor or component
+*
+* The object masks are invalidated by the FTags mutators (FTags::OnTagsChanged),
+* and are validated against a hash of the tag names on every lookup, so tags
+* changed outside of FTags (raw tag arrays, the Details panel) are picked up
+*/
+class UTAGS_API FTagTypeRegistry
+{
+public:
+	// Bitmask of tag type ids
+	typedef uint64 FTypeMask;
+
+	// Number of assignable type ids, the last bit marks types without an id
+	static constexpr int32 MaxTypeIds = 63;
+	static constexpr FTypeMask OverflowBit = 1ull << MaxTypeIds;
+
+	// Get the module wide registry
+	static FTagTypeRegistry& Get();
+
+	// Get the id of the type, registers it if needed, INDEX_NONE if all ids are in use
+	int32 RegisterType(const FString& TagType);
+
+	// Get the id of a registered type, INDEX_NONE if not registered
+	int32 FindTypeId(const FString& TagType) const;
+
+	// Get the type id of the tag, INDEX_NONE if it is untyped or its type has no id
+	int32 GetTagTypeId(const FName& InTag);
+
+	// Compute the type mask of the tags
+	FTypeMask GetTypeMask(const TArray<FName>& InTags);
+
+	// Get the cached type mask of the actor or component
+	FTypeMask GetObjectTypeMask(UObject* Object);
+
+	// Check if the actor or component has a tag of the type (a bit test for types with an id)
+	bool HasType(UObject* Object, const FString& TagType);
+
+	// Return the index of the first tag of the type in the tags array, INDEX_NONE if not found
+	int32 GetTagTypeIndex(const TArray<FName>& InTags, const FString& TagType);
+
+	// Return the index of the first tag of the type of the actor or component, INDEX_NONE if not found
+	int32 GetTagTypeIndex(UObject* Object, const FString& TagType);
+
+	// Drop the cached type mask of the object
+	void InvalidateObject(UObject* Object);
+
+	// Drop all cached names and masks (the type ids are kept)
+	void Empty();
+
+private:
+	// Compare the names case sensitive (same as the parse cache)
+	struct FNameKeyFuncs : TDefaultMapKeyFuncs<FName, int32, false>
+	{
+		static FORCEINLINE bool Matches(const FName& A, const FName& B)
+		{
+			return A.IsEqual(B, ENameCase::CaseSensitive);
+		}
+		static FORCEINLINE uint32 GetKeyHash(const FName& Key)
+		{
+			return GetTypeHash(Key);
+		}
+	};
+
+	// Register to the tags changed and garbage collection events
+	FTagTypeRegistry();
+
+	// Cached type mask of an object and the hash of the tag names it was computed from
+	struct FObjectMask
+	{
+		FTypeMask Mask;
+		uint32 TagsHash;
+	};
+
+	// Get the tags array of an actor or component, nullptr otherwise
+	static const TArray<FName>* GetObjectTags(UObject* Object);
+
+	// Hash of the tag names (name indices only, no string access)
+	static uint32 HashTags(const TArray<FName>& InTags);
+
+	// Get the cached type id of the tag (negative for untyped tags), parses and caches it on a miss
+	int32 FindOrAddTagTypeId(const FName& InTag);
+
+	// Get the cached type mask and the id of the type under a single lock, false if the object mask is not cached or stale
+	bool FindCachedMask(UObject* Object, uint32 TagsHash, const FString& TagType, FTypeMask& OutMask, int32& OutTypeId) const;
+
+	// Get the type mask of the object tags, computes and caches it on a miss
+	FTypeMask FindOrAddObjectTypeMask(UObject* Object, const TArray<FName>& InTags, uint32 TagsHash);
+
+	// Drop the masks of the collected objects
+	void OnPostGarbageCollect();
+
+	// Bitmask of the type id
+	static FORCEINLINE FTypeMask ToMask(int32 TypeId)
+	{
+		return TypeId == INDEX_NONE ? OverflowBit : (FTypeMask(1) << TypeId);
+	}
+
+	// Guards the containers
+	mutable FRWLock Lock;
+
+	// Type -> id
+	TMap<FString, int32> TypeIds;
+
+	// Tag name -> type id (UntypedId for untyped tags), bounded by the distinct tag names (names are never freed)
+	TMap<FName, int32, FDefaultSetAllocator, FNameKeyFuncs> NameTypeIds;
+
+	// Object -> cached type mask, entries are removed on change and after garbage collection
+	TMap<TWeakObjectPtr<UObject>, FObjectMask> ObjectMasks;
+};
@@ -0,0 +1,53 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+#include "CoreMinimal.h"
+#include "TagTokenizer.h"
+
+/**
+* Typed tag values, parsed from and formatted into stack buffers:
+*	int32 "42", float "0.25", bool "true"/"false" (or "1"/"0"),
+*	FVector "X|Y|Z", FQuat "X|Y|Z|W", FTransform "X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ]"
+*/
+struct UTAGS_API FTagValue
+{
+	// Separator of the vector, quaternion and transform components
+	static constexpr TCHAR Separator = TEXT('|');
+
+	// Formatted value, large enough for a transform
+	struct FBuffer
+	{
+		TCHAR Data[384];
+		int32 Len = 0;
+
+		// Copy the formatted value to a string
+		FString ToString() const { return FString(Len, Data); }
+
+		// View over the formatted value (valid while the buffer is alive)
+		FTagView GetView() const { return FTagView(Data, Len); }
+	};
+
+	// Parse the value, false if the text is not a valid value of the type
+	static bool Parse(const FTagView& InText, int32& OutValue);
+	static bool Parse(const FTagView& InText, float& OutValue);
+	static bool Parse(const FTagView& InText, bool& OutValue);
+	static bool Parse(const FTagView& InText, FVector& OutValue);
+	static bool Parse(const FTagView& InText, FQuat& OutValue);
+	static bool Parse(const FTagView& InText, FTransform& OutValue);
+
+	// Format the value (floats are written with round-trip precision)
+	static void Format(int32 InValue, FBuffer& OutBuffer);
+	static void Format(float InValue, FBuffer& OutBuffer);
+	static void Format(bool InValue, FBuffer& OutBuffer);
+	static void Format(const FVector& InValue, FBuffer& OutBuffer);
+	static void Format(const FQuat& InValue, FBuffer& OutBuffer);
+	static void Format(const FTransform& InValue, FBuffer& OutBuffer);
+
+private:
+	// Parse exactly Num separated floats
+	static bool ParseFloats(const FTagView& InText, float* OutValues, int32 Num);
+
+	// Append separated floats
+	static void FormatFloats(const float* InValues, int32 Num, FBuffer& OutBuffer);
+};
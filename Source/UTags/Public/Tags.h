@@ -4,8 +4,26 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "EngineUtils.h"
+#include "Async/Future.h"
+#include "TagTokenizer.h"
+#include "TagQuery.h"
+#include "TagValue.h"
+#include "TagStructBinding.h"
+#include "TagObjectResults.h"
 #include "Tags.generated.h"
 
+// Broadcast after the tags of an actor or component were changed through the FTags mutators
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTagsChanged, UObject* /*Owner*/);
+
+// How FTags::AssignUniqueIds treats the ids already present in the world
+enum class ETagIdPolicy : uint8
+{
+	// Keep the existing ids, new ones are assigned to the objects without an id or with a duplicate (ignoring case)
+	KeepExisting,
+
+	// Assign new ids to all the objects
+	RegenerateAll,
+};
 
 /*
 * FTagData - the structure of the tag data
@@ -46,6 +64,10 @@ struct UTAGS_API FTags
 	typedef TMap<AActor*, FTagData> ActorTagDataMap;
 	typedef TMap<UActorComponent*, FTagData> ComponentTagDataMap;
 
+	///////////////////////////////////////////////////////////////////////////
+	// Event triggered after an actor or component tags were changed by the FTags mutators
+	static FOnTagsChanged& OnTagsChanged();
+
 	///////////////////////////////////////////////////////////////////////////
 	// Return the index where the tag type was found in the array
 	static int32 GetTagTypeIndex(const TArray<FName>& InTags, const FString& TagType);
@@ -126,6 +148,127 @@ struct UTAGS_API FTags
 	// Get tag key value from object
 	static FString GetValue(UObject* Object, const FString& TagType, const FString& TagKey);
 
+	///////////////////////////////////////////////////////////////////////////
+	// Typed values, parsed from the tag without creating intermediate strings (see FTagValue for the formats),
+	// the getters return false if the key is missing or its value is not of the type
+
+	// Get the value of the key as an integer
+	static bool GetValueAsInt(const FName& InTag, const FString& TagKey, int32& OutValue);
+	static bool GetValueAsInt(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, int32& OutValue);
+	static bool GetValueAsInt(AActor* Actor, const FString& TagType, const FString& TagKey, int32& OutValue);
+	static bool GetValueAsInt(UActorComponent* Component, const FString& TagType, const FString& TagKey, int32& OutValue);
+	static bool GetValueAsInt(UObject* Object, const FString& TagType, const FString& TagKey, int32& OutValue);
+
+	// Get the value of the key as a float
+	static bool GetValueAsFloat(const FName& InTag, const FString& TagKey, float& OutValue);
+	static bool GetValueAsFloat(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, float& OutValue);
+	static bool GetValueAsFloat(AActor* Actor, const FString& TagType, const FString& TagKey, float& OutValue);
+	static bool GetValueAsFloat(UActorComponent* Component, const FString& TagType, const FString& TagKey, float& OutValue);
+	static bool GetValueAsFloat(UObject* Object, const FString& TagType, const FString& TagKey, float& OutValue);
+
+	// Get the value of the key as a bool
+	static bool GetValueAsBool(const FName& InTag, const FString& TagKey, bool& OutValue);
+	static bool GetValueAsBool(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, bool& OutValue);
+	static bool GetValueAsBool(AActor* Actor, const FString& TagType, const FString& TagKey, bool& OutValue);
+	static bool GetValueAsBool(UActorComponent* Component, const FString& TagType, const FString& TagKey, bool& OutValue);
+	static bool GetValueAsBool(UObject* Object, const FString& TagType, const FString& TagKey, bool& OutValue);
+
+	// Get the value of the key as a vector (X|Y|Z)
+	static bool GetValueAsVector(const FName& InTag, const FString& TagKey, FVector& OutValue);
+	static bool GetValueAsVector(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, FVector& OutValue);
+	static bool GetValueAsVector(AActor* Actor, const FString& TagType, const FString& TagKey, FVector& OutValue);
+	static bool GetValueAsVector(UActorComponent* Component, const FString& TagType, const FString& TagKey, FVector& OutValue);
+	static bool GetValueAsVector(UObject* Object, const FString& TagType, const FString& TagKey, FVector& OutValue);
+
+	// Get the value of the key as a quaternion (X|Y|Z|W)
+	static bool GetValueAsQuat(const FName& InTag, const FString& TagKey, FQuat& OutValue);
+	static bool GetValueAsQuat(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, FQuat& OutValue);
+	static bool GetValueAsQuat(AActor* Actor, const FString& TagType, const FString& TagKey, FQuat& OutValue);
+	static bool GetValueAsQuat(UActorComponent* Component, const FString& TagType, const FString& TagKey, FQuat& OutValue);
+	static bool GetValueAsQuat(UObject* Object, const FString& TagType, const FString& TagKey, FQuat& OutValue);
+
+	// Get the value of the key as a transform (X|Y|Z|QX|QY|QZ|QW[|SX|SY|SZ])
+	static bool GetValueAsTransform(const FName& InTag, const FString& TagKey, FTransform& OutValue);
+	static bool GetValueAsTransform(const TArray<FName>& InTags, const FString& TagType, const FString& TagKey, FTransform& OutValue);
+	static bool GetValueAsTransform(AActor* Actor, const FString& TagType, const FString& TagKey, FTransform& OutValue);
+	static bool GetValueAsTransform(UActorComponent* Component, const FString& TagType, const FString& TagKey, FTransform& OutValue);
+	static bool GetValueAsTransform(UObject* Object, const FString& TagType, const FString& TagKey, FTransform& OutValue);
+
+	// Add the key with an integer value (formatted into a stack buffer)
+	static bool AddKeyValuePairAsInt(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting = true, UObject* Owner = nullptr);
+	static bool AddKeyValuePairAsInt(AActor* Actor, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsInt(UActorComponent* Component, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsInt(UObject* Object, const FString& TagType, const FString& TagKey, int32 TagValue, bool bReplaceExisting = true);
+
+	// Add the key with a float value (formatted into a stack buffer)
+	static bool AddKeyValuePairAsFloat(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting = true, UObject* Owner = nullptr);
+	static bool AddKeyValuePairAsFloat(AActor* Actor, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsFloat(UActorComponent* Component, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsFloat(UObject* Object, const FString& TagType, const FString& TagKey, float TagValue, bool bReplaceExisting = true);
+
+	// Add the key with a bool value (formatted into a stack buffer)
+	static bool AddKeyValuePairAsBool(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting = true, UObject* Owner = nullptr);
+	static bool AddKeyValuePairAsBool(AActor* Actor, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsBool(UActorComponent* Component, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsBool(UObject* Object, const FString& TagType, const FString& TagKey, bool TagValue, bool bReplaceExisting = true);
+
+	// Add the key with a vector value (formatted into a stack buffer)
+	static bool AddKeyValuePairAsVector(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting = true, UObject* Owner = nullptr);
+	static bool AddKeyValuePairAsVector(AActor* Actor, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsVector(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsVector(UObject* Object, const FString& TagType, const FString& TagKey, const FVector& TagValue, bool bReplaceExisting = true);
+
+	// Add the key with a quaternion value (formatted into a stack buffer)
+	static bool AddKeyValuePairAsQuat(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting = true, UObject* Owner = nullptr);
+	static bool AddKeyValuePairAsQuat(AActor* Actor, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsQuat(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsQuat(UObject* Object, const FString& TagType, const FString& TagKey, const FQuat& TagValue, bool bReplaceExisting = true);
+
+	// Add the key with a transform value (formatted into a stack buffer)
+	static bool AddKeyValuePairAsTransform(TArray<FName>& InTags, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting = true, UObject* Owner = nullptr);
+	static bool AddKeyValuePairAsTransform(AActor* Actor, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsTransform(UActorComponent* Component, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting = true);
+	static bool AddKeyValuePairAsTransform(UObject* Object, const FString& TagType, const FString& TagKey, const FTransform& TagValue, bool bReplaceExisting = true);
+
+	///////////////////////////////////////////////////////////////////////////
+	// Read the tag type key value pairs into the USTRUCT fields of the same name (single parse), returns the number of set fields
+	template<typename StructType>
+	static int32 ReadStruct(const TArray<FName>& InTags, const FString& TagType, StructType& OutStruct)
+	{
+		return FTagStructBinding::Read(InTags, TagType, StructType::StaticStruct(), &OutStruct);
+	}
+
+	template<typename StructType>
+	static int32 ReadStruct(AActor* Actor, const FString& TagType, StructType& OutStruct)
+	{
+		return Actor ? FTagStructBinding::Read(Actor->Tags, TagType, StructType::StaticStruct(), &OutStruct, Actor) : 0;
+	}
+
+	template<typename StructType>
+	static int32 ReadStruct(UActorComponent* Component, const FString& TagType, StructType& OutStruct)
+	{
+		return Component ? FTagStructBinding::Read(Component->ComponentTags, TagType, StructType::StaticStruct(), &OutStruct, Component) : 0;
+	}
+
+	// Write the USTRUCT fields as key value pairs of the tag type, the tag is written at once, false if nothing changed
+	template<typename StructType>
+	static bool WriteStruct(TArray<FName>& InTags, const FString& TagType, const StructType& InStruct, UObject* Owner = nullptr)
+	{
+		return FTagStructBinding::Write(InTags, TagType, StructType::StaticStruct(), &InStruct, Owner);
+	}
+
+	template<typename StructType>
+	static bool WriteStruct(AActor* Actor, const FString& TagType, const StructType& InStruct)
+	{
+		return FTagStructBinding::Write(Actor, TagType, StructType::StaticStruct(), &InStruct);
+	}
+
+	template<typename StructType>
+	static bool WriteStruct(UActorComponent* Component, const FString& TagType, const StructType& InStruct)
+	{
+		return FTagStructBinding::Write(Component, TagType, StructType::StaticStruct(), &InStruct);
+	}
+
 	///////////////////////////////////////////////////////////////////////////
 	// Add tag key value to tag, if bReplaceExisting is true, replace existing value
 	static bool AddKeyValuePair(FName& InTag, const FString& TagKey, const FString& TagValue, bool bReplaceExisting = true, UObject* Owner = nullptr);
@@ -204,9 +347,13 @@ struct UTAGS_API FTags
 	// Remove tag key value from component
 	static bool RemoveKeyValuePair(UActorComponent* Component, const FString& TagType, const FString& TagKey);
 
-	// Remove all tag key values from world
+	// Remove all tag key values from world (actors and components of every loaded level)
 	static bool RemoveAllKeyValuePairs(UWorld* World, const FString& TagType, const FString& TagKey);
 
+	// Assign unique ids (base64url GUIDs) to the key of every actor and component with the tag type,
+	// the ids are generated in parallel and all the tags are rewritten in a single pass, returns the number of assigned ids
+	static int32 AssignUniqueIds(UWorld* World, const FString& TagType, const FString& TagKey = TEXT("Id"), ETagIdPolicy Policy = ETagIdPolicy::KeepExisting);
+
 
 	///////////////////////////////////////////////////////////////////////////
 	// Get tag key value pairs from tag array
@@ -232,6 +379,9 @@ struct UTAGS_API FTags
 	// Get all components to tag key value pairs from world
 	static TMap<UActorComponent*, TMap<FString, FString>> GetComponentsToKeyValuePairs(UWorld* World, const FString& TagType);
 
+	// Get the objects (actor and actor components) to tag key value pairs of every given tag type, in a single world pass
+	static TMap<FString, TMap<UObject*, TMap<FString, FString>>> GetObjectKeyValuePairsMaps(UWorld* World, const TSet<FString>& TagTypes);
+
 
 	/////////////////////////////////////////////////////////////////////////
 	// Get all objects unique id (actor and actor components) to tag key value
@@ -247,6 +397,21 @@ struct UTAGS_API FTags
 	static TMap<UActorComponent*, FString> GetComponentsToKeyValue(UWorld* World, const FString& TagType, const FString& TagKey);
 
 
+	/////////////////////////////////////////////////////////////////////////
+	// Dense versions, parallel arrays sorted by object index (binary search lookup, contiguous iteration)
+	// Get all objects (actor and actor components) with their tag key value
+	static TTagObjectResults<FString> GetObjectsToKeyValueDense(UWorld* World, const FString& TagType, const FString& TagKey);
+
+	// Get all actors with their tag key value
+	static TTagObjectResults<FString> GetActorsToKeyValueDense(UWorld* World, const FString& TagType, const FString& TagKey);
+
+	// Get all components with their tag key value
+	static TTagObjectResults<FString> GetComponentsToKeyValueDense(UWorld* World, const FString& TagType, const FString& TagKey);
+
+	// Get all objects (actor and actor components) with their tag key value pairs
+	static TTagObjectResults<TMap<FString, FString>> GetObjectKeyValuePairsDense(UWorld* World, const FString& TagType);
+
+
 	/////////////////////////////////////////////////////////////////////////
 	// Get key values to objects (actor and actor components)
 	static TMap<FString, UObject*> GetKeyValuesToObject(UWorld* World, const FString& TagType, const FString& TagKey);
@@ -279,11 +444,108 @@ struct UTAGS_API FTags
 	// Gets all components with the key value pair
 	static TSet<UActorComponent*> GetComponentSetWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue);
 
+	///////////////////////////////////////////////////////////////////////////
+	// Call the callback with every object (actor and actor components) having the tag type key and its value,
+	// return false from the callback to stop, the value view is only valid during the call
+	static void ForEachObjectWithTag(UWorld* World, const FString& TagType, const FString& TagKey, TFunctionRef<bool(UObject*, const FTagView&)> Callback);
+
+	// Call the callback with every object (actor and actor components) having the key value pair, return false from the callback to stop
+	static void ForEachObjectWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue, TFunctionRef<bool(UObject*)> Callback);
+
+	// Get the first object (actor or actor component) with the key value pair, nullptr if none
+	static UObject* FindFirstObjectWithKeyValuePair(UWorld* World, const FString& TagType, const FString& TagKey, const FString& TagValue);
+
+	///////////////////////////////////////////////////////////////////////////
+	// Numeric value queries, answered from the sorted values of the world tag index if enabled (non numeric values are skipped)
+	// Get all objects (actor and actor components) with the value of the tag type key in [Min, Max], in ascending value order
+	static TArray<UObject*> GetObjectsWithValueInRange(UWorld* World, const FString& TagType, const FString& TagKey, float Min, float Max);
+
+	// Get the (up to) K objects with the largest values of the tag type key, largest first (or the smallest, smallest first)
+	static TArray<UObject*> GetObjectsWithTopValues(UWorld* World, const FString& TagType, const FString& TagKey, int32 K, bool bLargest = true);
+
+	// Get the (up to) K objects with the values of the tag type key closest to the value, closest first
+	static TArray<UObject*> GetObjectsWithNearestValues(UWorld* World, const FString& TagType, const FString& TagKey, float Value, int32 K = 1);
+
+	///////////////////////////////////////////////////////////////////////////
+	// Partial value queries (ignoring case), answered from the sorted values of the world tag index if enabled
+	// Get all objects (actor and actor components) with the value of the tag type key starting with the prefix
+	static TArray<UObject*> GetObjectsWithValuePrefix(UWorld* World, const FString& TagType, const FString& TagKey, const FString& Prefix);
+
+	// Get all objects (actor and actor components) with the value of the tag type key ending with the suffix
+	static TArray<UObject*> GetObjectsWithValueSuffix(UWorld* World, const FString& TagType, const FString& TagKey, const FString& Suffix);
+
+	// Get all objects (actor and actor components) with the value of the tag type key matching the wildcard pattern ('*' and '?')
+	static TArray<UObject*> GetObjectsWithValueMatching(UWorld* World, const FString& TagType, const FString& TagKey, const FString& Pattern);
+
+	///////////////////////////////////////////////////////////////////////////
+	// Prepared query versions, the query is built once and can be reused across calls
+	// Get all actors matching the query as array
+	static TArray<AActor*> GetActorsWithKeyValuePair(UWorld* World, const FTagQuery& Query);
+
+	// Get all actors matching the query as set
+	static TSet<AActor*> GetActorsWithKeyValuePairAsSet(UWorld* World, const FTagQuery& Query);
+
+	// Get all components matching the query as array
+	static TArray<UActorComponent*> GetComponentsWithKeyValuePair(UWorld* World, const FTagQuery& Query);
+
+	// Get all components matching the query as set
+	static TSet<UActorComponent*> GetComponentsWithKeyValuePairAsSet(UWorld* World, const FTagQuery& Query);
+
+	// Call the callback with every object (actor and actor components) matching the query, return false from the callback to stop
+	static void ForEachObjectWithKeyValuePair(UWorld* World, const FTagQuery& Query, TFunctionRef<bool(UObject*)> Callback);
+
+	// Get the first object (actor or actor component) matching the query, nullptr if none
+	static UObject* FindFirstObjectWithKeyValuePair(UWorld* World, const FTagQuery& Query);
+
+	///////////////////////////////////////////////////////////////////////////
+	// Combined tag and spatial queries on the actors matching the query (by actor location),
+	// answered from the tag spatial index if enabled and the query has a tag type
+	// Get all actors matching the query inside the box
+	static TArray<AActor*> GetActorsInBox(UWorld* World, const FTagQuery& Query, const FBox& Box);
+
+	// Get all actors matching the query inside the sphere
+	static TArray<AActor*> GetActorsInSphere(UWorld* World, const FTagQuery& Query, const FVector& Center, float Radius);
+
+	// Get the (up to) K actors matching the query closest to the location (within the max distance), closest first
+	static TArray<AActor*> GetNearestActors(UWorld* World, const FTagQuery& Query, const FVector& Location, int32 K, float MaxDistance = MAX_flt);
+
 	///////////////////////////////////////////////////////////////////////////
 	// Get all the tags from the all the actors in the world which includes the Tags of each actor's components
 	static TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> GetWorldTagsData(UWorld * World);
 	// Get all the Tags Data (TagType and Key/Values) from a given Object
-	static TArray<FTagData> GetObjectTagsData(TArray<FName>& TagsData, UObject* ObjectOfActorOrComponent);
+	static TArray<FTagData> GetObjectTagsData(const TArray<FName>& TagsData, UObject* ObjectOfActorOrComponent);
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// Parallel versions, the objects are collected on the calling thread, the tags are parsed
+	// across cores, the results are merged in the same order as the serial versions
+	// Get all objects (actor and actor components) to tag key value pairs from world
+	static TMap<UObject*, TMap<FString, FString>> GetObjectKeyValuePairsMapParallel(UWorld* World, const FString& TagType);
+
+	// Get all actors to tag key value pairs from world
+	static TMap<AActor*, TMap<FString, FString>> GetActorsToKeyValuePairsParallel(UWorld* World, const FString& TagType);
+
+	// Get all components to tag key value pairs from world
+	static TMap<UActorComponent*, TMap<FString, FString>> GetComponentsToKeyValuePairsParallel(UWorld* World, const FString& TagType);
+
+	// Get all the tags data of the actors and their components from the world
+	static TMap<TWeakObjectPtr<UObject>, TArray<FTagData>> GetWorldTagsDataParallel(UWorld* World);
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// Asynchronous versions, the tag arrays are copied on the game thread, parsed and filtered
+	// on the task graph; the results are either returned as futures, or passed to the callback on the game thread
+	// Get all objects (actor and actor components) to tag key value
+	static TFuture<TMap<TWeakObjectPtr<UObject>, FString>> GetObjectsToKeyValueAsync(UWorld* World, const FString& TagType, const FString& TagKey);
+	static void GetObjectsToKeyValueAsync(UWorld* World, const FString& TagType, const FString& TagKey, TFunction<void(const TMap<TWeakObjectPtr<UObject>, FString>&)> OnComplete);
+
+	// Get all objects (actor and actor components) to tag key value pairs
+	static TFuture<TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>> GetObjectKeyValuePairsMapAsync(UWorld* World, const FString& TagType);
+	static void GetObjectKeyValuePairsMapAsync(UWorld* World, const FString& TagType, TFunction<void(const TMap<TWeakObjectPtr<UObject>, TMap<FString, FString>>&)> OnComplete);
+
+	// Get all objects (actor and actor components) matching the query
+	static TFuture<TArray<TWeakObjectPtr<UObject>>> GetObjectsWithKeyValuePairAsync(UWorld* World, const FTagQuery& Query);
+	static void GetObjectsWithKeyValuePairAsync(UWorld* World, const FTagQuery& Query, TFunction<void(const TArray<TWeakObjectPtr<UObject>>&)> OnComplete);
 
 
 };
@@ -38,6 +38,7 @@ public class UTags : ModuleRules
 			{
 				"CoreUObject",				
 				"Slate",
+				"UIds",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
 			}